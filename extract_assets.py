@@ -1,6 +1,6 @@
 #!/usr/bin/env python3
 
-import argparse, json, os, signal, time, colorama, multiprocessing
+import argparse, json, os, signal, tempfile, time, colorama, multiprocessing
 
 colorama.init()
 
@@ -11,67 +11,90 @@ def SignalHandler(sig, frame):
     mainAbort.set()
     # Don't exit immediately to update the extracted assets file.
 
-def ExtractFile(xmlPath, outputPath, outputSourcePath):
+def GetOutputPaths(fullPath):
+    *pathList, xmlName = fullPath.split(os.sep)
+    objectName = os.path.splitext(xmlName)[0]
+
+    if "scenes" in pathList:
+        outPath = os.path.join("assets", *pathList[2:])
+    else:
+        outPath = os.path.join("assets", *pathList[2:], objectName)
+    outSourcePath = outPath
+
+    return outPath, outSourcePath
+
+def IsExtractionNeeded(fullPath, extractedAssetsTracker):
+    if fullPath in extractedAssetsTracker:
+        timestamp = extractedAssetsTracker[fullPath]["timestamp"]
+        modificationTime = int(os.path.getmtime(fullPath))
+        if modificationTime < timestamp:
+            # XML has not been modified since last extraction.
+            return False
+    return True
+
+def ExtractFiles(xmlPaths):
     if globalAbort.is_set():
         # Don't extract if another file wasn't extracted properly.
         return
 
-    execStr = f"tools/ZAPD/ZAPD.out e -eh -i {xmlPath} -b baserom/ -o {outputPath} -osf {outputSourcePath} -gsf 1 -rconf tools/ZAPDConfigs/MM/Config.xml {ZAPDArgs}"
+    # A single ZAPD process extracts the whole list, so the config and its external files are only
+    # loaded once instead of once per XML.
+    with tempfile.NamedTemporaryFile("w", prefix="zapd_extract_", suffix=".txt", delete=False) as listFile:
+        for xmlPath in xmlPaths:
+            outPath, outSourcePath = GetOutputPaths(xmlPath)
+            # Tab-separated, so the paths can contain spaces
+            listFile.write(f"{xmlPath}\t{outPath}\t{outSourcePath}\n")
+
+    execStr = f"tools/ZAPD/ZAPD.out e -eh -il {listFile.name} -j {globalJobs} -b baserom/ -gsf 1 -rconf tools/ZAPDConfigs/MM/Config.xml {ZAPDArgs}"
 
     if globalUnaccounted:
         execStr += " -Wunaccounted"
 
     print(execStr)
     exitValue = os.system(execStr)
+    os.remove(listFile.name)
     if exitValue != 0:
         globalAbort.set()
         print("\n")
-        print("Error when extracting from file " + xmlPath, file=os.sys.stderr)
+        print("Error when extracting from files " + ", ".join(xmlPaths), file=os.sys.stderr)
         print("Aborting...", file=os.sys.stderr)
         print("\n")
 
-def ExtractFunc(fullPath):
-    *pathList, xmlName = fullPath.split(os.sep)
-    objectName = os.path.splitext(xmlName)[0]
-
-    if "scenes" in pathList:
-        outPath = os.path.join("assets", *pathList[2:])
-    else:
-        outPath = os.path.join("assets", *pathList[2:], objectName)
-    outSourcePath = outPath
-
-    if fullPath in globalExtractedAssetsTracker:
-        timestamp = globalExtractedAssetsTracker[fullPath]["timestamp"]
-        modificationTime = int(os.path.getmtime(fullPath))
-        if modificationTime < timestamp:
-            # XML has not been modified since last extraction.
-            return
+def ExtractFunc(xmlPaths):
+    if len(xmlPaths) == 0:
+        return
 
     currentTimeStamp = int(time.time())
 
-    ExtractFile(fullPath, outPath, outSourcePath)
+    ExtractFiles(xmlPaths)
 
     if not globalAbort.is_set():
         # Only update timestamp on succesful extractions
-        if fullPath not in globalExtractedAssetsTracker:
-            globalExtractedAssetsTracker[fullPath] = globalManager.dict()
-        globalExtractedAssetsTracker[fullPath]["timestamp"] = currentTimeStamp
+        for fullPath in xmlPaths:
+            if fullPath not in globalExtractedAssetsTracker:
+                globalExtractedAssetsTracker[fullPath] = globalManager.dict()
+            globalExtractedAssetsTracker[fullPath]["timestamp"] = currentTimeStamp
 
-def initializeWorker(abort, unaccounted: bool, extractedAssetsTracker: dict, manager):
+def initializeWorker(abort, unaccounted: bool, extractedAssetsTracker: dict, manager, jobs: int):
     global globalAbort
     global globalUnaccounted
     global globalExtractedAssetsTracker
     global globalManager
+    global globalJobs
     globalAbort = abort
     globalUnaccounted = unaccounted
     globalExtractedAssetsTracker = extractedAssetsTracker
     globalManager = manager
+    globalJobs = jobs
 
 def main():
     parser = argparse.ArgumentParser(description="baserom asset extractor")
     parser.add_argument("-s", "--single", help="asset path relative to assets/, e.g. objects/gameplay_keep")
     parser.add_argument("-f", "--force", help="Force the extraction of every xml instead of checking the touched ones.", action="store_true")
     parser.add_argument("-j", "--jobs", help="Number of cpu cores to extract with.")
+    parser.add_argument("-c", "--cache-dir", help="Folder where ZAPD caches the extracted assets. XMLs whose inputs match a cached extraction are restored from it instead of being extracted again, so the folder can be shared between clones.")
+    parser.add_argument("-p", "--png-profile", help="How ZAPD compresses the extracted PNGs: `default` (smallest files), `fast` or `uncompressed` (fastest to write).", choices=["default", "fast", "uncompressed"])
+    parser.add_argument("-d", "--dedup-textures", help="Only write one PNG per unique texture, and list the other copies next to it in the given manifest file. The build converts each unique PNG once for all its copies. As the copies of a texture can be in any XML, every XML is extracted again as soon as one of them has to be.", metavar="MANIFEST")
     parser.add_argument("-u", "--unaccounted", help="Enables ZAPD unaccounted detector warning system.", action="store_true")
     parser.add_argument("-Z", help="Pass the argument on to ZAPD, e.g. `-ZWunaccounted` to warn about unaccounted blocks in XMLs. Each argument should be passed separately, *without* the leading dash.", metavar="ZAPD_ARG", action="append")
     args = parser.parse_args()
@@ -94,6 +117,19 @@ def main():
         ZAPDArgs = " ".join(args.Z)
         print("Using extra ZAPD arguments: " + ZAPDArgs)
 
+    if args.cache_dir is not None:
+        ZAPDArgs += f" --cache-dir {args.cache_dir}"
+
+    if args.png_profile is not None:
+        ZAPDArgs += f" --png-profile {args.png_profile}"
+
+    if args.dedup_textures is not None:
+        if args.single is not None:
+            print(f"{colorama.Fore.LIGHTRED_EX}error{colorama.Fore.RESET}: --dedup-textures needs every xml to be extracted, it can't be used with --single.", file=os.sys.stderr)
+            exit(1)
+
+        ZAPDArgs += f" --dedup-textures {args.dedup_textures}"
+
     global mainAbort
     mainAbort = multiprocessing.Event()
     manager = multiprocessing.Manager()
@@ -104,6 +140,10 @@ def main():
         with open(EXTRACTED_ASSETS_NAMEFILE, encoding='utf-8') as f:
             extractedAssetsTracker.update(json.load(f, object_hook=manager.dict))
 
+    numCores = int(args.jobs or 0)
+    if numCores <= 0:
+        numCores = 1
+
     asset_path = args.single
     if asset_path is not None:
         fullPath = os.path.join("assets", "xml", asset_path + ".xml")
@@ -111,33 +151,30 @@ def main():
             print(f"Error. File {fullPath} does not exist.", file=os.sys.stderr)
             exit(1)
 
-        initializeWorker(mainAbort, args.unaccounted, extractedAssetsTracker, manager)
+        initializeWorker(mainAbort, args.unaccounted, extractedAssetsTracker, manager, numCores)
         # Always extract if -s is used.
         if fullPath in extractedAssetsTracker:
             del extractedAssetsTracker[fullPath]
-        ExtractFunc(fullPath)
+        ExtractFunc([fullPath])
     else:
         xmlFiles = []
+        allXmlFiles = []
         for currentPath, _, files in os.walk(os.path.join("assets", "xml")):
             for file in files:
                 fullPath = os.path.join(currentPath, file)
                 if file.endswith(".xml"):
-                    xmlFiles.append(fullPath)
-
-        try:
-            numCores = int(args.jobs or 0)
-            if numCores <= 0:
-                numCores = 1
-            print("Extracting assets with " + str(numCores) + " CPU core" + ("s" if numCores > 1 else "") + ".")
-            with multiprocessing.get_context("fork").Pool(numCores,  initializer=initializeWorker, initargs=(mainAbort, args.unaccounted, extractedAssetsTracker, manager)) as p:
-                p.map(ExtractFunc, xmlFiles)
-        except (multiprocessing.ProcessError, TypeError):
-            print("Warning: Multiprocessing exception ocurred.", file=os.sys.stderr)
-            print("Disabling mutliprocessing.", file=os.sys.stderr)
-
-            initializeWorker(mainAbort, args.unaccounted, extractedAssetsTracker, manager)
-            for singlePath in xmlFiles:
-                ExtractFunc(singlePath)
+                    allXmlFiles.append(fullPath)
+                    if IsExtractionNeeded(fullPath, extractedAssetsTracker):
+                        xmlFiles.append(fullPath)
+
+        # The manifest has to know about every texture
+        if args.dedup_textures is not None and len(xmlFiles) > 0:
+            xmlFiles = allXmlFiles
+
+        print("Extracting assets with " + str(numCores) + " CPU core" + ("s" if numCores > 1 else "") + ".")
+        # A single ZAPD process extracts every XML, spreading them across its own threads.
+        initializeWorker(mainAbort, args.unaccounted, extractedAssetsTracker, manager, numCores)
+        ExtractFunc(xmlFiles)
 
     with open(EXTRACTED_ASSETS_NAMEFILE, 'w', encoding='utf-8') as f:
         serializableDict = dict()
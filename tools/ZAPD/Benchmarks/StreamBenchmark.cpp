@@ -0,0 +1,159 @@
+/**
+ * Microbenchmarks of the ZAPDUtils streams, writers and readers.
+ * Build and run with `make benchmarks && ./Benchmarks/StreamBenchmark.out [value count]`.
+ *
+ * Every case writes or reads the same array of big-endian 16-bit values and prints the fastest of
+ * a few runs, in nanoseconds per value.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Utils/BinaryReader.h"
+#include "Utils/BinaryWriter.h"
+#include "Utils/BitConverter.h"
+#include "Utils/MemoryStream.h"
+#include "Utils/SpanReader.h"
+
+namespace
+{
+constexpr int runCount = 5;
+
+// Keeps the compiler from removing the work of a case
+volatile uint64_t sink;
+
+// MemoryStream as it was before it grew geometrically: the buffer is resized to exactly the
+// written length on each write.
+class ExactResizeStream
+{
+public:
+	void Write(const char* src, size_t length)
+	{
+		if (position + length >= buffer.size())
+			buffer.resize(position + length);
+
+		std::copy(src, src + length, buffer.begin() + position);
+		position += length;
+	}
+
+	void WriteByte(char value)
+	{
+		if (position >= buffer.size())
+			buffer.resize(position + 1);
+
+		buffer[position++] = value;
+	}
+
+	size_t GetLength() const { return buffer.size(); }
+
+protected:
+	std::vector<char> buffer;
+	size_t position = 0;
+};
+
+void Run(const char* name, size_t count, const std::function<uint64_t()>& benchmark)
+{
+	double best = 0;
+
+	for (int i = 0; i < runCount; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		sink = benchmark();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (i == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+
+	printf("  %-48s %8.2f ns/value\n", name, best / count);
+}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 0) : 1 << 20;
+
+	std::vector<uint16_t> values(count);
+	for (size_t i = 0; i < count; i++)
+		values[i] = (i * 0x9E37) & 0xFFFF;
+
+	std::vector<uint8_t> bigEndian(count * 2);
+	for (size_t i = 0; i < count; i++)
+	{
+		bigEndian[i * 2 + 0] = values[i] >> 8;
+		bigEndian[i * 2 + 1] = values[i] & 0xFF;
+	}
+
+	printf("%zu u16 values\n", count);
+
+	printf("Writing:\n");
+	Run("byte at a time, exact resize (old MemoryStream)", count, [&]() {
+		ExactResizeStream stream;
+		for (uint16_t value : values)
+		{
+			stream.WriteByte(value >> 8);
+			stream.WriteByte(value & 0xFF);
+		}
+		return stream.GetLength();
+	});
+	Run("byte at a time, MemoryStream", count, [&]() {
+		MemoryStream stream;
+		for (uint16_t value : values)
+		{
+			stream.WriteByte(value >> 8);
+			stream.WriteByte(value & 0xFF);
+		}
+		return stream.GetLength();
+	});
+	Run("BinaryWriter::Write per value", count, [&]() {
+		BinaryWriter writer(std::make_shared<MemoryStream>());
+		for (uint16_t value : values)
+			writer.Write((uint16_t)((value >> 8) | (value << 8)));
+		return writer.GetLength();
+	});
+	Run("BinaryWriter::WriteArrayBE", count, [&]() {
+		BinaryWriter writer(std::make_shared<MemoryStream>());
+		writer.WriteArrayBE(values.data(), values.size());
+		return writer.GetLength();
+	});
+
+	printf("Reading:\n");
+	std::vector<uint16_t> dest(count);
+	Run("BinaryReader::ReadUInt16 per value", count, [&]() {
+		BinaryReader reader(new MemoryStream((char*)bigEndian.data(), bigEndian.size()));
+		for (size_t i = 0; i < count; i++)
+		{
+			uint16_t value = reader.ReadUInt16();
+			dest[i] = (value >> 8) | (value << 8);
+		}
+		return dest[count - 1];
+	});
+	Run("BinaryReader::ReadArrayBE", count, [&]() {
+		BinaryReader reader(new MemoryStream((char*)bigEndian.data(), bigEndian.size()));
+		reader.ReadArrayBE(dest.data(), count);
+		return dest[count - 1];
+	});
+	Run("BitConverter::ToUInt16BE per value", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			dest[i] = BitConverter::ToUInt16BE(bigEndian, i * 2);
+		return dest[count - 1];
+	});
+	Run("SpanReader::ReadUInt16BE per value", count, [&]() {
+		SpanReader reader(bigEndian);
+		for (size_t i = 0; i < count; i++)
+			dest[i] = reader.ReadUInt16BE();
+		return dest[count - 1];
+	});
+	Run("SpanReader::ReadArrayBE", count, [&]() {
+		SpanReader reader(bigEndian);
+		reader.ReadArrayBE(dest.data(), count);
+		return dest[count - 1];
+	});
+
+	return 0;
+}
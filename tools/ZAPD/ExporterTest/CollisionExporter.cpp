@@ -34,12 +34,11 @@ void ExporterExample_Collision::Save(ZResource* res, [[maybe_unused]] fs::path o
 
 	writer->Seek(col->vtxSegmentOffset, SeekOffsetType::Start);
 
-	for (uint16_t i = 0; i < col->vertices.size(); i++)
+	for (const auto& vtx : col->vertices)
 	{
-		for (uint32_t j = 0; j < col->vertices[i].dimensions; j++)
-		{
-			writer->Write(col->vertices[i].scalars[j].scalarData.s16);
-		}
+		writer->Write(vtx.x);
+		writer->Write(vtx.y);
+		writer->Write(vtx.z);
 	}
 
 	writer->Seek(col->polySegmentOffset, SeekOffsetType::Start);
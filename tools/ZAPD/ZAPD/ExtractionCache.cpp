@@ -0,0 +1,198 @@
+#include "ExtractionCache.h"
+
+#include <algorithm>
+#include <random>
+#include <string_view>
+
+#include "Globals.h"
+#include "Utils/File.h"
+#include "Utils/MappedFile.h"
+#include "Utils/Path.h"
+#include "Utils/StringHelper.h"
+#include "tinyxml2.h"
+
+extern const char gBuildHash[];
+
+uint64_t ExtractionCache::ComputeSharedHash()
+{
+	Globals* g = Globals::Instance;
+	uint64_t hash = 0xCBF29CE484222325;  // FNV-1a offset basis
+
+	std::string options = StringHelper::Sprintf(
+		"%i %i %i %i %i %i %i %i %i %i %i %i", static_cast<int>(g->fileMode),
+		static_cast<int>(g->game), g->genSourceFile, g->useExternalResources, g->testMode,
+		g->outputCrc, g->useLegacyZDList, g->verboseUnaccounted, g->gccCompat, g->forceStatic,
+		g->forceUnaccountedStatic, static_cast<int>(g->pngWriteProfile));
+
+	HashString(hash, gBuildHash);
+	HashString(hash, options);
+
+	HashConfig(hash);
+
+	return hash;
+}
+
+std::string ExtractionCache::ComputeKey(const fs::path& xmlFilePath, uint64_t sharedHash)
+{
+	Globals* g = Globals::Instance;
+	uint64_t hash = sharedHash;
+
+	// The output paths end up in the generated includes
+	HashString(hash, g->outputPath.string());
+	HashString(hash, g->sourceOutputPath.string());
+
+	HashXml(hash, xmlFilePath);
+
+	return StringHelper::Sprintf("%016llX", (unsigned long long)hash);
+}
+
+bool ExtractionCache::Restore(const std::string& key)
+{
+	fs::path entryPath = Globals::Instance->extractionCacheDir / key;
+	fs::path manifestPath = entryPath / "manifest.txt";
+
+	if (!File::Exists(manifestPath))
+		return false;
+
+	size_t index = 0;
+	for (const std::string& line : File::ReadAllLines(manifestPath))
+	{
+		if (line == "")
+			continue;
+
+		fs::path outputFile = line;
+
+		if (outputFile.has_parent_path())
+			Directory::CreateDirectory(outputFile.parent_path().string());
+
+		File::WriteAllBytesIfChanged(outputFile,
+		                             File::ReadAllBytes(entryPath / std::to_string(index)));
+		index++;
+	}
+
+	return true;
+}
+
+void ExtractionCache::Store(const std::string& key, std::vector<fs::path> outputFiles)
+{
+	fs::path entryPath = Globals::Instance->extractionCacheDir / key;
+
+	if (Directory::Exists(entryPath))
+		return;
+
+	std::sort(outputFiles.begin(), outputFiles.end());
+	outputFiles.erase(std::unique(outputFiles.begin(), outputFiles.end()), outputFiles.end());
+
+	// The entry is written to a temporary folder and then renamed, so other ZAPD processes sharing
+	// the cache never see a partial entry.
+	fs::path tempPath = Globals::Instance->extractionCacheDir /
+	                    StringHelper::Sprintf("%s.%08X.tmp", key.c_str(), std::random_device()());
+	std::string manifest;
+
+	Directory::CreateDirectory(tempPath.string());
+
+	for (size_t i = 0; i < outputFiles.size(); i++)
+	{
+		fs::copy_file(outputFiles[i], tempPath / std::to_string(i));
+		manifest += outputFiles[i].string() + "\n";
+	}
+
+	File::WriteAllText(tempPath / "manifest.txt", manifest);
+
+	std::error_code error;
+	fs::rename(tempPath, entryPath, error);
+
+	// Another process stored the same entry in the meantime
+	if (error)
+		fs::remove_all(tempPath, error);
+}
+
+void ExtractionCache::HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001B3;  // FNV-1a prime
+	}
+}
+
+void ExtractionCache::HashString(uint64_t& hash, const std::string& str)
+{
+	// Hashing the terminator too keeps consecutive strings from running into each other
+	HashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+void ExtractionCache::HashFile(uint64_t& hash, const fs::path& filePath)
+{
+	HashString(hash, filePath.string());
+
+	MappedFile file;
+
+	if (!file.Open(filePath))
+	{
+		HashString(hash, "<missing>");
+		return;
+	}
+
+	ByteSpan data = file.GetData();
+	uint64_t size = data.size();
+
+	HashBytes(hash, &size, sizeof(size));
+	HashBytes(hash, data.data(), data.size());
+}
+
+void ExtractionCache::HashXml(uint64_t& hash, const fs::path& xmlFilePath)
+{
+	HashFile(hash, xmlFilePath);
+
+	tinyxml2::XMLDocument doc;
+	if (doc.LoadFile(xmlFilePath.string().c_str()) != tinyxml2::XML_SUCCESS ||
+	    doc.FirstChild() == nullptr)
+		return;
+
+	for (tinyxml2::XMLElement* child = doc.FirstChild()->FirstChildElement(); child != nullptr;
+	     child = child->NextSiblingElement())
+	{
+		if (std::string_view(child->Name()) == "File")
+		{
+			const char* name = child->Attribute("Name");
+			if (name != nullptr)
+				HashFile(hash, Globals::Instance->baseRomPath / name);
+		}
+		else if (std::string_view(child->Name()) == "ExternalFile")
+		{
+			const char* xmlPathValue = child->Attribute("XmlPath");
+			if (xmlPathValue != nullptr)
+				HashXml(hash, Globals::Instance->cfg.externalXmlFolder / xmlPathValue);
+		}
+	}
+}
+
+void ExtractionCache::HashConfig(uint64_t& hash)
+{
+	GameConfig& cfg = Globals::Instance->cfg;
+
+	if (cfg.configFilePath == "")
+		return;
+
+	HashFile(hash, cfg.configFilePath);
+
+	tinyxml2::XMLDocument doc;
+	if (doc.LoadFile(cfg.configFilePath.c_str()) != tinyxml2::XML_SUCCESS ||
+	    doc.FirstChild() == nullptr)
+		return;
+
+	// Symbol map, actor list, texture pool...
+	for (tinyxml2::XMLElement* child = doc.FirstChild()->FirstChildElement(); child != nullptr;
+	     child = child->NextSiblingElement())
+	{
+		const char* fileName = child->Attribute("File");
+		if (fileName != nullptr)
+			HashFile(hash, Path::GetDirectoryName(cfg.configFilePath) / fileName);
+	}
+
+	for (const ExternalFile& extFile : cfg.externalFiles)
+		HashXml(hash, cfg.externalXmlFolder / extFile.xmlPath);
+}
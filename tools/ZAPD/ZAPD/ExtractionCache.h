@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Utils/Directory.h"
+
+/**
+ * Content-addressed cache of extraction outputs, enabled with `--cache-dir`.
+ *
+ * An XML is extracted again only if the cache has no entry for its key, which covers everything
+ * the output depends on: the XML, the baserom files it references, the external XMLs (and their
+ * baserom files), the config and the files it references, the options of the context and the
+ * ZAPD build hash. The part of the key that is the same for every XML of a run (build, options,
+ * config and its external XMLs) is computed once by `ComputeSharedHash`. Every entry is a folder
+ * named after its key, holding a copy of each output file and a `manifest.txt` listing the paths
+ * those copies are restored to.
+ */
+class ExtractionCache
+{
+public:
+	// Hashes the build, the options of the context, the config, the files it references and its
+	// external XMLs. The config and its external files must have been loaded.
+	static uint64_t ComputeSharedHash();
+	// Key of `xmlFilePath`: `sharedHash` combined with the XML, its baserom files, its own external
+	// XMLs and the output paths of the context.
+	static std::string ComputeKey(const fs::path& xmlFilePath, uint64_t sharedHash);
+
+	// Copies the output files of the entry `key` back to their paths. Returns false on a miss.
+	static bool Restore(const std::string& key);
+	static void Store(const std::string& key, std::vector<fs::path> outputFiles);
+
+protected:
+	static void HashBytes(uint64_t& hash, const void* data, size_t size);
+	static void HashString(uint64_t& hash, const std::string& str);
+	static void HashFile(uint64_t& hash, const fs::path& filePath);
+	static void HashXml(uint64_t& hash, const fs::path& xmlFilePath);
+	static void HashConfig(uint64_t& hash);
+};
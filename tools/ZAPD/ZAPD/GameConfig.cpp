@@ -12,17 +12,6 @@
 
 using ConfigFunc = void (GameConfig::*)(const tinyxml2::XMLElement&);
 
-GameConfig::~GameConfig()
-{
-	for (auto& declPair : segmentRefFiles)
-	{
-		for (auto& file : declPair.second)
-		{
-			delete file;
-		}
-	}
-}
-
 void GameConfig::ReadTexturePool(const fs::path& texturePoolXmlPath)
 {
 	tinyxml2::XMLDocument doc;
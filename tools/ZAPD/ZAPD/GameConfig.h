@@ -21,13 +21,10 @@ public:
 	ExternalFile(fs::path nXmlPath, fs::path nOutPath);
 };
 
-class ZFile;
-
 class GameConfig
 {
 public:
 	std::string configFilePath;
-	std::map<int32_t, std::vector<ZFile*>> segmentRefFiles;
 	std::map<uint32_t, std::string> symbolMap;
 	std::vector<std::string> actorList;
 	std::vector<std::string> objectList;
@@ -45,7 +42,6 @@ public:
 	std::vector<ExternalFile> externalFiles;
 
 	GameConfig() = default;
-	~GameConfig();
 
 	void ReadTexturePool(const fs::path& texturePoolXmlPath);
 	void GenSymbolMap(const fs::path& symbolMapPath);
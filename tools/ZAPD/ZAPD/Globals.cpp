@@ -8,9 +8,9 @@
 #include "WarningHandler.h"
 #include "tinyxml2.h"
 
-Globals* Globals::Instance;
+thread_local Globals* Globals::Instance;
 
-Globals::Globals()
+Globals::Globals() : ownedCfg{new GameConfig()}, cfg{*ownedCfg}
 {
 	Instance = this;
 
@@ -24,24 +24,70 @@ Globals::Globals()
 	outputPath = Directory::GetCurrentDirectory();
 }
 
+Globals::Globals(Globals* nSharedContext) : cfg{nSharedContext->cfg}
+{
+	sharedContext = nSharedContext;
+	sharedFilesCount = nSharedContext->files.size();
+	Instance = this;
+
+	genSourceFile = sharedContext->genSourceFile;
+	useExternalResources = sharedContext->useExternalResources;
+	testMode = sharedContext->testMode;
+	outputCrc = sharedContext->outputCrc;
+	profile = sharedContext->profile;
+	useLegacyZDList = sharedContext->useLegacyZDList;
+	verbosity = sharedContext->verbosity;
+	fileMode = sharedContext->fileMode;
+	baseRomPath = sharedContext->baseRomPath;
+	inputPath = sharedContext->inputPath;
+	outputPath = sharedContext->outputPath;
+	sourceOutputPath = sharedContext->sourceOutputPath;
+	cfgPath = sharedContext->cfgPath;
+	extractionCacheDir = sharedContext->extractionCacheDir;
+	extractionCacheSharedHash = sharedContext->extractionCacheSharedHash;
+	textureDedupManifestPath = sharedContext->textureDedupManifestPath;
+	texType = sharedContext->texType;
+	game = sharedContext->game;
+	verboseUnaccounted = sharedContext->verboseUnaccounted;
+	gccCompat = sharedContext->gccCompat;
+	forceStatic = sharedContext->forceStatic;
+	forceUnaccountedStatic = sharedContext->forceUnaccountedStatic;
+	pngWriteProfile = sharedContext->pngWriteProfile;
+	currentExporter = sharedContext->currentExporter;
+
+	files = sharedContext->files;
+	externalFiles = sharedContext->externalFiles;
+	segments = sharedContext->segments;
+	segmentRefFiles = sharedContext->segmentRefFiles;
+}
+
 Globals::~Globals()
 {
-	auto& exporters = GetExporterMap();
+	for (size_t i = sharedFilesCount; i < files.size(); i++)
+		delete files[i];
 
-	for (auto& it : exporters)
+	if (sharedContext == nullptr)
 	{
-		delete it.second;
+		auto& exporters = GetExporterMap();
+
+		for (auto& it : exporters)
+		{
+			delete it.second;
+		}
 	}
+
+	if (Instance == this)
+		Instance = sharedContext;
 }
 
 void Globals::AddSegment(int32_t segment, ZFile* file)
 {
 	if (std::find(segments.begin(), segments.end(), segment) == segments.end())
 		segments.push_back(segment);
-	if (cfg.segmentRefFiles.find(segment) == cfg.segmentRefFiles.end())
-		cfg.segmentRefFiles[segment] = std::vector<ZFile*>();
+	if (segmentRefFiles.find(segment) == segmentRefFiles.end())
+		segmentRefFiles[segment] = std::vector<ZFile*>();
 
-	cfg.segmentRefFiles[segment].push_back(file);
+	segmentRefFiles[segment].push_back(file);
 }
 
 bool Globals::HasSegment(int32_t segment)
@@ -49,6 +95,64 @@ bool Globals::HasSegment(int32_t segment)
 	return std::find(segments.begin(), segments.end(), segment) != segments.end();
 }
 
+void Globals::AddSegmentedRef(segptr_t segAddress, size_t size, ZFile* file)
+{
+	std::vector<ZFile*>& refFiles = segmentedRefs[segAddress];
+
+	if (std::find(refFiles.begin(), refFiles.end(), file) == refFiles.end())
+		refFiles.push_back(file);
+
+	maxSegmentedRefSize = std::max(maxSegmentedRefSize, size);
+}
+
+/**
+ * Returns the files of the segment of `segAddress` which have a declaration or a symbol starting
+ * at it, or containing it if `ranged` is set. They are sorted in the same order as in
+ * `segmentRefFiles`, so the first file to resolve the address is the same one as when every file
+ * of the segment was asked.
+ */
+std::vector<ZFile*> Globals::GetSegmentedRefFiles(segptr_t segAddress, bool ranged)
+{
+	std::vector<ZFile*> refFiles;
+
+	for (Globals* context = this; context != nullptr; context = context->sharedContext)
+	{
+		segptr_t start = segAddress;
+
+		// Only the entries starting less than maxSegmentedRefSize bytes before the address can
+		// contain it
+		if (ranged && context->maxSegmentedRefSize > 0)
+		{
+			if (GETSEGOFFSET(segAddress) >= context->maxSegmentedRefSize)
+				start = segAddress - context->maxSegmentedRefSize + 1;
+			else
+				start = segAddress & 0xFF000000;
+		}
+
+		for (auto it = context->segmentedRefs.lower_bound(start);
+		     it != context->segmentedRefs.end() && it->first <= segAddress; it++)
+		{
+			for (ZFile* file : it->second)
+			{
+				if (std::find(refFiles.begin(), refFiles.end(), file) == refFiles.end())
+					refFiles.push_back(file);
+			}
+		}
+	}
+
+	if (refFiles.size() <= 1)
+		return refFiles;
+
+	std::vector<ZFile*> sortedRefFiles;
+	for (ZFile* file : segmentRefFiles[GETSEGNUM(segAddress)])
+	{
+		if (std::find(refFiles.begin(), refFiles.end(), file) != refFiles.end())
+			sortedRefFiles.push_back(file);
+	}
+
+	return sortedRefFiles;
+}
+
 std::map<std::string, ExporterSet*>& Globals::GetExporterMap()
 {
 	static std::map<std::string, ExporterSet*> exporters;
@@ -122,7 +226,7 @@ bool Globals::GetSegmentedPtrName(segptr_t segAddress, ZFile* currentFile,
 	}
 	else if (HasSegment(segment))
 	{
-		for (auto file : cfg.segmentRefFiles[segment])
+		for (auto file : GetSegmentedRefFiles(segAddress, false))
 		{
 			offset = Seg2Filespace(segAddress, file->baseAddress);
 
@@ -189,7 +293,7 @@ bool Globals::GetSegmentedArrayIndexedName(segptr_t segAddress, size_t elementSi
 	}
 	else if (HasSegment(segment))
 	{
-		for (auto file : cfg.segmentRefFiles[segment])
+		for (auto file : GetSegmentedRefFiles(segAddress, true))
 		{
 			if (file->IsSegmentedInFilespaceRange(segAddress))
 			{
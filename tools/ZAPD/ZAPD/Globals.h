@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "GameConfig.h"
@@ -18,8 +19,13 @@ enum class VerbosityLevel
 
 class Globals
 {
+private:
+	// Only the main context owns a config, the job contexts share it.
+	std::unique_ptr<GameConfig> ownedCfg;
+
 public:
-	static Globals* Instance;
+	// Context of the current thread
+	static thread_local Globals* Instance;
 
 	bool genSourceFile;  // Used for extraction
 	bool useExternalResources;
@@ -29,29 +35,46 @@ public:
 	bool useLegacyZDList;
 	VerbosityLevel verbosity;  // ZAPD outputs additional information
 	ZFileMode fileMode;
-	fs::path baseRomPath, inputPath, outputPath, sourceOutputPath, cfgPath;
+	fs::path baseRomPath, inputPath, outputPath, sourceOutputPath, cfgPath, inputListPath,
+	    extractionCacheDir, profileReportPath, profileTracePath, textureDedupManifestPath;
 	TextureType texType;
 	ZGame game;
-	GameConfig cfg;
+	GameConfig& cfg;
 	bool verboseUnaccounted = false;
 	bool gccCompat = false;
 	bool forceStatic = false;
 	bool forceUnaccountedStatic = false;
+	uint32_t jobCount = 1;  // Number of XMLs extracted at the same time in list mode
+	PngWriteProfile pngWriteProfile = PngWriteProfile::Default;
+	// Part of the extraction cache keys shared by every XML, see ExtractionCache::ComputeSharedHash
+	uint64_t extractionCacheSharedHash = 0;
 
 	std::vector<ZFile*> files;
 	std::vector<ZFile*> externalFiles;
 	std::vector<int32_t> segments;
+	std::map<int32_t, std::vector<ZFile*>> segmentRefFiles;
+	std::vector<fs::path> outputFiles;  // Files written by this context, for the extraction cache
 
 	std::string currentExporter;
 	static std::map<std::string, ExporterSet*>& GetExporterMap();
 	static void AddExporter(std::string exporterName, ExporterSet* exporterSet);
 
 	Globals();
+	/**
+	 * Creates a context to extract an XML in parallel with others. It shares the config and the
+	 * files loaded so far (namely the external files of the config) with `nSharedContext`, so those
+	 * must not be modified while the job context is alive. Files added to the job context are
+	 * owned by it, and the context becomes the current one of the thread that creates it.
+	 */
+	explicit Globals(Globals* nSharedContext);
 	~Globals();
 
 	void AddSegment(int32_t segment, ZFile* file);
 	bool HasSegment(int32_t segment);
 
+	// Records that `file` has a declaration (or a symbol) of `size` bytes at `segAddress`
+	void AddSegmentedRef(segptr_t segAddress, size_t size, ZFile* file);
+
 	ZResourceExporter* GetExporter(ZResourceType resType);
 	ExporterSet* GetExporterSet();
 
@@ -74,4 +97,16 @@ public:
 	// TODO: consider moving to another place
 	void WarnHardcodedPointer(segptr_t segAddress, ZFile* currentFile, ZResource* res,
 	                          offset_t currentOffset);
+
+protected:
+	Globals* sharedContext = nullptr;
+	size_t sharedFilesCount = 0;
+
+	// Index of the declarations and symbols of every file by segmented address, so a pointer to
+	// another file is resolved by asking only the files having something declared there. The job
+	// contexts only index their own files and look up the shared context's index too.
+	std::map<segptr_t, std::vector<ZFile*>> segmentedRefs;
+	size_t maxSegmentedRefSize = 0;
+
+	std::vector<ZFile*> GetSegmentedRefFiles(segptr_t segAddress, bool ranged);
 };
@@ -5,6 +5,7 @@
 #include <png.h>
 #include <stdexcept>
 
+#include "Profiler.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 
@@ -17,6 +18,8 @@ ImageBackend::~ImageBackend()
 
 void ImageBackend::ReadPng(const char* filename)
 {
+	ProfileScope profileScope("ReadPng");
+
 	FreeImageData();
 
 	FILE* fp = fopen(filename, "rb");
@@ -109,17 +112,12 @@ void ImageBackend::ReadPng(const char* filename)
 
 	png_read_update_info(png, info);
 
-	size_t rowBytes = png_get_rowbytes(png, info);
-	pixelMatrix = (uint8_t**)malloc(sizeof(uint8_t*) * height);
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = (uint8_t*)malloc(rowBytes);
-	}
-
+	// libpng decodes straight into the image buffer
+	AllocateImageData(png_get_rowbytes(png, info), false);
 	png_read_image(png, pixelMatrix);
 
 #ifdef TEXTURE_DEBUG
-	printf("rowBytes: %zu\n", rowBytes);
+	printf("rowBytes: %zu\n", rowStride);
 
 	size_t bytePerPixel = GetBytesPerPixel();
 	printf("imgData\n");
@@ -141,8 +139,6 @@ void ImageBackend::ReadPng(const char* filename)
 	fclose(fp);
 
 	png_destroy_read_struct(&png, &info, nullptr);
-
-	hasImageData = true;
 }
 
 void ImageBackend::ReadPng(const fs::path& filename)
@@ -150,8 +146,10 @@ void ImageBackend::ReadPng(const fs::path& filename)
 	ReadPng(filename.c_str());
 }
 
-void ImageBackend::WritePng(const char* filename)
+void ImageBackend::WritePng(const char* filename, PngWriteProfile profile)
 {
+	ProfileScope profileScope("WritePng");
+
 	assert(hasImageData);
 
 	FILE* fp = fopen(filename, "wb");
@@ -182,6 +180,22 @@ void ImageBackend::WritePng(const char* filename)
 
 	png_init_io(png, fp);
 
+	switch (profile)
+	{
+	case PngWriteProfile::Default:
+		break;
+
+	case PngWriteProfile::Fast:
+		png_set_compression_level(png, 1);  // Z_BEST_SPEED
+		png_set_filter(png, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+		break;
+
+	case PngWriteProfile::Uncompressed:
+		png_set_compression_level(png, 0);  // Z_NO_COMPRESSION
+		png_set_filter(png, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+		break;
+	}
+
 	png_set_IHDR(png, info, width, height,
 	             bitDepth,   // 8,
 	             colorType,  // PNG_COLOR_TYPE_RGBA,
@@ -234,16 +248,15 @@ void ImageBackend::WritePng(const char* filename)
 	png_destroy_write_struct(&png, &info);
 }
 
-void ImageBackend::WritePng(const fs::path& filename)
+void ImageBackend::WritePng(const fs::path& filename, PngWriteProfile profile)
 {
 	// Note: The .string() is necessary for MSVC, due to the implementation of std::filesystem
 	// differing from GCC. Do not remove!
-	WritePng(filename.string().c_str());
+	WritePng(filename.string().c_str(), profile);
 }
 
-void ImageBackend::SetTextureData(const std::vector<std::vector<RGBAPixel>>& texData,
-                                  uint32_t nWidth, uint32_t nHeight, uint8_t nColorType,
-                                  uint8_t nBitDepth)
+void ImageBackend::SetTextureData(const std::vector<RGBAPixel>& texData, uint32_t nWidth,
+                                  uint32_t nHeight, uint8_t nColorType, uint8_t nBitDepth)
 {
 	FreeImageData();
 
@@ -252,23 +265,22 @@ void ImageBackend::SetTextureData(const std::vector<std::vector<RGBAPixel>>& tex
 	colorType = nColorType;
 	bitDepth = nBitDepth;
 
+	assert(texData.size() >= static_cast<size_t>(width) * height);
+
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = static_cast<uint8_t**>(malloc(sizeof(uint8_t*) * height));
-	for (size_t y = 0; y < height; y++)
+	AllocateImageData(width * bytePerPixel, false);
+
+	uint8_t* dst = pixelData;
+	for (size_t i = 0; i < static_cast<size_t>(width) * height; i++, dst += bytePerPixel)
 	{
-		pixelMatrix[y] = static_cast<uint8_t*>(malloc(sizeof(uint8_t*) * width * bytePerPixel));
-		for (size_t x = 0; x < width; x++)
-		{
-			pixelMatrix[y][x * bytePerPixel + 0] = texData.at(y).at(x).r;
-			pixelMatrix[y][x * bytePerPixel + 1] = texData.at(y).at(x).g;
-			pixelMatrix[y][x * bytePerPixel + 2] = texData.at(y).at(x).b;
+		dst[0] = texData[i].r;
+		dst[1] = texData[i].g;
+		dst[2] = texData[i].b;
 
-			if (colorType == PNG_COLOR_TYPE_RGBA)
-				pixelMatrix[y][x * bytePerPixel + 3] = texData.at(y).at(x).a;
-		}
+		if (colorType == PNG_COLOR_TYPE_RGBA)
+			dst[3] = texData[i].a;
 	}
-	hasImageData = true;
 }
 
 void ImageBackend::InitEmptyRGBImage(uint32_t nWidth, uint32_t nHeight, bool alpha)
@@ -284,13 +296,7 @@ void ImageBackend::InitEmptyRGBImage(uint32_t nWidth, uint32_t nHeight, bool alp
 
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = static_cast<uint8_t**>(malloc(sizeof(uint8_t*) * height));
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = static_cast<uint8_t*>(calloc(width * bytePerPixel, sizeof(uint8_t*)));
-	}
-
-	hasImageData = true;
+	AllocateImageData(width * bytePerPixel, true);
 }
 
 void ImageBackend::InitEmptyPaletteImage(uint32_t nWidth, uint32_t nHeight)
@@ -304,15 +310,10 @@ void ImageBackend::InitEmptyPaletteImage(uint32_t nWidth, uint32_t nHeight)
 
 	size_t bytePerPixel = GetBytesPerPixel();
 
-	pixelMatrix = (uint8_t**)malloc(sizeof(uint8_t*) * height);
-	for (size_t y = 0; y < height; y++)
-	{
-		pixelMatrix[y] = static_cast<uint8_t*>(calloc(width * bytePerPixel, sizeof(uint8_t*)));
-	}
+	AllocateImageData(width * bytePerPixel, true);
 	colorPalette = calloc(paletteSize, sizeof(png_color));
 	alphaPalette = static_cast<uint8_t*>(calloc(paletteSize, sizeof(uint8_t)));
 
-	hasImageData = true;
 	isColorIndexed = true;
 }
 
@@ -341,6 +342,51 @@ uint8_t ImageBackend::GetIndexedPixel(size_t y, size_t x) const
 	return pixelMatrix[y][x];
 }
 
+uint8_t* ImageBackend::GetRow(size_t y)
+{
+	assert(hasImageData);
+	assert(y < height);
+
+	return pixelMatrix[y];
+}
+
+const uint8_t* ImageBackend::GetRow(size_t y) const
+{
+	assert(hasImageData);
+	assert(y < height);
+
+	return pixelMatrix[y];
+}
+
+size_t ImageBackend::GetPixelStride() const
+{
+	return GetBytesPerPixel();
+}
+
+bool ImageBackend::HasAlphaChannel() const
+{
+	return colorType == PNG_COLOR_TYPE_RGBA;
+}
+
+uint8_t* ImageBackend::GetImageData()
+{
+	assert(hasImageData);
+
+	return pixelData;
+}
+
+const uint8_t* ImageBackend::GetImageData() const
+{
+	assert(hasImageData);
+
+	return pixelData;
+}
+
+size_t ImageBackend::GetRowStride() const
+{
+	return rowStride;
+}
+
 void ImageBackend::SetRGBPixel(size_t y, size_t x, uint8_t nR, uint8_t nG, uint8_t nB, uint8_t nA)
 {
 	assert(hasImageData);
@@ -465,14 +511,32 @@ double ImageBackend::GetBytesPerPixel() const
 	}
 }
 
+void ImageBackend::AllocateImageData(size_t nRowStride, bool clear)
+{
+	rowStride = nRowStride;
+
+	size_t dataSize = rowStride * height;
+	if (clear)
+		pixelData = static_cast<uint8_t*>(calloc(dataSize, sizeof(uint8_t)));
+	else
+		pixelData = static_cast<uint8_t*>(malloc(dataSize));
+
+	pixelMatrix = static_cast<uint8_t**>(malloc(sizeof(uint8_t*) * height));
+	for (size_t y = 0; y < height; y++)
+		pixelMatrix[y] = pixelData + y * rowStride;
+
+	hasImageData = true;
+}
+
 void ImageBackend::FreeImageData()
 {
 	if (hasImageData)
 	{
-		for (size_t y = 0; y < height; y++)
-			free(pixelMatrix[y]);
+		free(pixelData);
 		free(pixelMatrix);
+		pixelData = nullptr;
 		pixelMatrix = nullptr;
+		rowStride = 0;
 	}
 
 	if (isColorIndexed)
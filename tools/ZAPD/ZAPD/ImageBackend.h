@@ -19,6 +19,14 @@ public:
 	uint8_t a = 0;
 };
 
+// zlib level and row filters used when writing PNGs
+enum class PngWriteProfile
+{
+	Default,       // libpng defaults: zlib level 6 and adaptive filtering, smallest files
+	Fast,          // zlib level 1 without filtering
+	Uncompressed,  // zlib stored blocks, no deflate at all
+};
+
 class ImageBackend
 {
 public:
@@ -27,17 +35,31 @@ public:
 
 	void ReadPng(const char* filename);
 	void ReadPng(const fs::path& filename);
-	void WritePng(const char* filename);
-	void WritePng(const fs::path& filename);
+	void WritePng(const char* filename, PngWriteProfile profile = PngWriteProfile::Default);
+	void WritePng(const fs::path& filename, PngWriteProfile profile = PngWriteProfile::Default);
 
-	void SetTextureData(const std::vector<std::vector<RGBAPixel>>& texData, uint32_t nWidth,
-	                    uint32_t nHeight, uint8_t nColorType, uint8_t nBitDepth);
+	// `texData` holds the `nWidth * nHeight` pixels of the image, row after row.
+	void SetTextureData(const std::vector<RGBAPixel>& texData, uint32_t nWidth, uint32_t nHeight,
+	                    uint8_t nColorType, uint8_t nBitDepth);
 	void InitEmptyRGBImage(uint32_t nWidth, uint32_t nHeight, bool alpha);
 	void InitEmptyPaletteImage(uint32_t nWidth, uint32_t nHeight);
 
 	RGBAPixel GetPixel(size_t y, size_t x) const;
 	uint8_t GetIndexedPixel(size_t y, size_t x) const;
 
+	// Raw access to the pixels of the row `y`, `GetPixelStride()` bytes per pixel, for the codecs
+	// that convert whole rows at once.
+	uint8_t* GetRow(size_t y);
+	const uint8_t* GetRow(size_t y) const;
+	size_t GetPixelStride() const;
+	bool HasAlphaChannel() const;
+
+	// The rows are stored one after the other, `GetRowStride()` bytes apart, so whole images can
+	// be converted at once too.
+	uint8_t* GetImageData();
+	const uint8_t* GetImageData() const;
+	size_t GetRowStride() const;
+
 	void SetRGBPixel(size_t y, size_t x, uint8_t nR, uint8_t nG, uint8_t nB, uint8_t nA = 0);
 	void SetGrayscalePixel(size_t y, size_t x, uint8_t grayscale, uint8_t alpha = 0);
 
@@ -52,7 +74,9 @@ public:
 	uint8_t GetBitDepth() const;
 
 protected:
-	uint8_t** pixelMatrix = nullptr;  // height * [width * bytePerPixel]
+	uint8_t* pixelData = nullptr;     // height * rowStride, in a single allocation
+	uint8_t** pixelMatrix = nullptr;  // Pointers to the rows of pixelData, as libpng wants them
+	size_t rowStride = 0;
 
 	void* colorPalette = nullptr;
 	uint8_t* alphaPalette = nullptr;
@@ -68,5 +92,6 @@ protected:
 
 	double GetBytesPerPixel() const;
 
+	void AllocateImageData(size_t nRowStride, bool clear);
 	void FreeImageData();
 };
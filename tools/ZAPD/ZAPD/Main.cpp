@@ -1,4 +1,7 @@
+#include "ExtractionCache.h"
 #include "Globals.h"
+#include "Profiler.h"
+#include "TextureDedupPool.h"
 #include "Utils/Directory.h"
 #include "Utils/File.h"
 #include "Utils/Path.h"
@@ -12,12 +15,31 @@
 #include <functional>
 #include "CrashHandler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include "tinyxml2.h"
 
 using ArgFunc = void (*)(int&, char**);
 
+struct ExtractionJob
+{
+	fs::path xmlPath;
+	fs::path outputPath;
+	fs::path sourceOutputPath;
+};
+
+struct TextureBuildJob
+{
+	fs::path pngPath;
+	std::vector<fs::path> outPaths;  // Every output converted from the same PNG
+	TextureType texType;
+};
+
 void Arg_SetOutputPath(int& i, char* argv[]);
 void Arg_SetInputPath(int& i, char* argv[]);
 void Arg_SetBaseromPath(int& i, char* argv[]);
@@ -36,19 +58,38 @@ void Arg_SetExporter(int& i, char* argv[]);
 void Arg_EnableGCCCompat(int& i, char* argv[]);
 void Arg_ForceStatic(int& i, char* argv[]);
 void Arg_ForceUnaccountedStatic(int& i, char* argv[]);
+void Arg_SetInputListPath(int& i, char* argv[]);
+void Arg_SetJobCount(int& i, char* argv[]);
+void Arg_SetExtractionCacheDir(int& i, char* argv[]);
+void Arg_SetProfileReportPath(int& i, char* argv[]);
+void Arg_SetProfileTracePath(int& i, char* argv[]);
+void Arg_SetPngWriteProfile(int& i, char* argv[]);
+void Arg_SetTextureDedupManifestPath(int& i, char* argv[]);
 
 int main(int argc, char* argv[]);
 
 bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path& outPath,
            ZFileMode fileMode);
+bool ParseCached(const fs::path& xmlFilePath, ZFileMode fileMode);
 
 void ParseArgs(int& argc, char* argv[]);
 
-void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const fs::path& outPath);
+void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType,
+                       const std::vector<fs::path>& outPaths, bool onlyIfChanged);
 void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath);
 void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath);
 ZFileMode ParseFileMode(const std::string& buildMode, ExporterSet* exporterSet);
 int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet);
+bool ParseConfigExternalFiles();
+bool ReadListFile(const fs::path& listPath, size_t minColumns, size_t maxColumns,
+                  const char* lineFormat, std::vector<std::vector<std::string>>& entries);
+bool RunListJobs(size_t jobCount, size_t threadCount, const std::function<bool(size_t)>& runJob);
+bool ReadExtractionList(const fs::path& listPath, std::vector<ExtractionJob>& jobs);
+bool ExtractListJob(Globals* sharedContext, const ExtractionJob& job, ZFileMode fileMode);
+int HandleExtractList(ZFileMode fileMode);
+bool ReadTextureBuildList(const fs::path& listPath, std::vector<TextureBuildJob>& jobs);
+bool BuildTextureListJob(Globals* sharedContext, const TextureBuildJob& job);
+int HandleBuildTextureList();
 
 extern const char gBuildHash[];
 
@@ -110,16 +151,26 @@ int main(int argc, char* argv[])
 	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_DEBUG)
 		WarningHandler::PrintWarningsDebugInfo();
 
+	if (Globals::Instance->profileReportPath != "" || Globals::Instance->profileTracePath != "")
+		Profiler::Enable();
+
 	if (fileMode == ZFileMode::Extract || fileMode == ZFileMode::BuildSourceFile)
 		returnCode = HandleExtract(fileMode, exporterSet);
+	else if (fileMode == ZFileMode::BuildTexture && Globals::Instance->inputListPath != "")
+		returnCode = HandleBuildTextureList();
 	else if (fileMode == ZFileMode::BuildTexture)
 		BuildAssetTexture(Globals::Instance->inputPath, Globals::Instance->texType,
-		                  Globals::Instance->outputPath);
+		                  {Globals::Instance->outputPath}, false);
 	else if (fileMode == ZFileMode::BuildBackground)
 		BuildAssetBackground(Globals::Instance->inputPath, Globals::Instance->outputPath);
 	else if (fileMode == ZFileMode::BuildBlob)
 		BuildAssetBlob(Globals::Instance->inputPath, Globals::Instance->outputPath);
 
+	if (g->profileReportPath != "")
+		Profiler::WriteReport(g->profileReportPath);
+	if (g->profileTracePath != "")
+		Profiler::WriteTrace(g->profileTracePath);
+
 	delete g;
 	return returnCode;
 }
@@ -128,7 +179,12 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
            ZFileMode fileMode)
 {
 	tinyxml2::XMLDocument doc;
-	tinyxml2::XMLError eResult = doc.LoadFile(xmlFilePath.string().c_str());
+	tinyxml2::XMLError eResult;
+
+	{
+		ProfileScope profileScope("LoadXml");
+		eResult = doc.LoadFile(xmlFilePath.string().c_str());
+	}
 
 	if (eResult != tinyxml2::XML_SUCCESS)
 	{
@@ -224,6 +280,45 @@ bool Parse(const fs::path& xmlFilePath, const fs::path& basePath, const fs::path
 	return true;
 }
 
+/**
+ * Extracts `xmlFilePath` with the current context. If `--cache-dir` was passed, the outputs are
+ * restored from the extraction cache instead when it already has them, and stored in it otherwise.
+ */
+bool ParseCached(const fs::path& xmlFilePath, ZFileMode fileMode)
+{
+	ProfileScope profileScope("Extract");
+	Globals* g = Globals::Instance;
+	std::string cacheKey;
+
+	// Exporters write outputs of their own that aren't tracked, and which textures are written
+	// depends on the other files when they are deduplicated
+	bool useCache = g->extractionCacheDir != "" && fileMode == ZFileMode::Extract &&
+	                g->GetExporterSet() == nullptr && g->textureDedupManifestPath == "";
+
+	if (useCache)
+	{
+		cacheKey = ExtractionCache::ComputeKey(xmlFilePath, g->extractionCacheSharedHash);
+
+		if (ExtractionCache::Restore(cacheKey))
+		{
+			if (g->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+				printf("Restored '%s' from the extraction cache\n", xmlFilePath.c_str());
+
+			return true;
+		}
+	}
+
+	g->outputFiles.clear();
+
+	if (!Parse(xmlFilePath, g->baseRomPath, g->outputPath, fileMode))
+		return false;
+
+	if (useCache)
+		ExtractionCache::Store(cacheKey, g->outputFiles);
+
+	return true;
+}
+
 void ParseArgs(int& argc, char* argv[])
 {
 	static const std::unordered_map<std::string, ArgFunc> ArgFuncDictionary = {
@@ -252,6 +347,15 @@ void ParseArgs(int& argc, char* argv[])
 		{"--static", &Arg_ForceStatic},
 		{"-us", &Arg_ForceUnaccountedStatic},
 		{"--unaccounted-static", &Arg_ForceUnaccountedStatic},
+		{"-il", &Arg_SetInputListPath},
+		{"--input-list", &Arg_SetInputListPath},
+		{"-j", &Arg_SetJobCount},
+		{"--jobs", &Arg_SetJobCount},
+		{"--cache-dir", &Arg_SetExtractionCacheDir},
+		{"--profile-report", &Arg_SetProfileReportPath},
+		{"--profile-trace", &Arg_SetProfileTracePath},
+		{"--png-profile", &Arg_SetPngWriteProfile},
+		{"--dedup-textures", &Arg_SetTextureDedupManifestPath},
 	};
 
 	for (int32_t i = 2; i < argc; i++)
@@ -392,6 +496,55 @@ void Arg_ForceUnaccountedStatic([[maybe_unused]] int& i, [[maybe_unused]] char*
 	Globals::Instance->forceUnaccountedStatic = true;
 }
 
+void Arg_SetInputListPath(int& i, char* argv[])
+{
+	Globals::Instance->inputListPath = argv[++i];
+}
+
+void Arg_SetJobCount(int& i, char* argv[])
+{
+	Globals::Instance->jobCount = strtoul(argv[++i], NULL, 10);
+
+	if (Globals::Instance->jobCount == 0)
+		Globals::Instance->jobCount = std::thread::hardware_concurrency();
+}
+
+void Arg_SetExtractionCacheDir(int& i, char* argv[])
+{
+	Globals::Instance->extractionCacheDir = argv[++i];
+}
+
+void Arg_SetProfileReportPath(int& i, char* argv[])
+{
+	Globals::Instance->profileReportPath = argv[++i];
+}
+
+void Arg_SetProfileTracePath(int& i, char* argv[])
+{
+	Globals::Instance->profileTracePath = argv[++i];
+}
+
+void Arg_SetPngWriteProfile(int& i, char* argv[])
+{
+	std::string_view profile = argv[++i];
+
+	if (profile == "default")
+		Globals::Instance->pngWriteProfile = PngWriteProfile::Default;
+	else if (profile == "fast")
+		Globals::Instance->pngWriteProfile = PngWriteProfile::Fast;
+	else if (profile == "uncompressed")
+		Globals::Instance->pngWriteProfile = PngWriteProfile::Uncompressed;
+	else
+		HANDLE_ERROR(WarningType::InvalidAttributeValue,
+		             StringHelper::Sprintf("invalid PNG profile '%s'", argv[i]),
+		             "Valid values are 'default', 'fast' and 'uncompressed'");
+}
+
+void Arg_SetTextureDedupManifestPath(int& i, char* argv[])
+{
+	Globals::Instance->textureDedupManifestPath = argv[++i];
+}
+
 int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet)
 {
 	bool procFileModeSuccess = false;
@@ -401,35 +554,301 @@ int HandleExtract(ZFileMode fileMode, ExporterSet* exporterSet)
 
 	if (!procFileModeSuccess)
 	{
-		bool parseSuccessful;
+		if (!ParseConfigExternalFiles())
+			return 1;
+
+		// Only the XMLs differ between the extraction cache keys of a run
+		if (Globals::Instance->extractionCacheDir != "")
+			Globals::Instance->extractionCacheSharedHash = ExtractionCache::ComputeSharedHash();
 
-		for (auto& extFile : Globals::Instance->cfg.externalFiles)
+		if (Globals::Instance->inputListPath != "")
 		{
-			fs::path externalXmlFilePath =
-				Globals::Instance->cfg.externalXmlFolder / extFile.xmlPath;
+			if (HandleExtractList(fileMode) != 0)
+				return 1;
+		}
+		else if (!ParseCached(Globals::Instance->inputPath, fileMode))
+			return 1;
 
-			if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
-				printf("Parsing external file from config: '%s'\n", externalXmlFilePath.c_str());
+		// Only now are all the copies of each texture known
+		if (Globals::Instance->textureDedupManifestPath != "")
+			TextureDedupPool::WriteManifest(Globals::Instance->textureDedupManifestPath);
+	}
 
-			parseSuccessful = Parse(externalXmlFilePath, Globals::Instance->baseRomPath,
-			                        extFile.outPath, ZFileMode::ExternalFile);
+	return 0;
+}
 
-			if (!parseSuccessful)
-				return 1;
-		}
+bool ParseConfigExternalFiles()
+{
+	for (auto& extFile : Globals::Instance->cfg.externalFiles)
+	{
+		fs::path externalXmlFilePath = Globals::Instance->cfg.externalXmlFolder / extFile.xmlPath;
+
+		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
+			printf("Parsing external file from config: '%s'\n", externalXmlFilePath.c_str());
+
+		bool parseSuccessful = Parse(externalXmlFilePath, Globals::Instance->baseRomPath,
+		                             extFile.outPath, ZFileMode::ExternalFile);
 
-		parseSuccessful = Parse(Globals::Instance->inputPath, Globals::Instance->baseRomPath,
-		                        Globals::Instance->outputPath, fileMode);
 		if (!parseSuccessful)
-			return 1;
+			return false;
 	}
 
-	return 0;
+	return true;
+}
+
+/**
+ * Reads a list file made of tab-separated columns, one entry per non-empty line, so paths can
+ * contain spaces. The spaces around a column are ignored, as make's `$(foreach)` puts one before
+ * each line it writes. Lines starting with `#` are ignored. `lineFormat` is only used to report
+ * malformed lines.
+ */
+bool ReadListFile(const fs::path& listPath, size_t minColumns, size_t maxColumns,
+                  const char* lineFormat, std::vector<std::vector<std::string>>& entries)
+{
+	if (!File::Exists(listPath))
+	{
+		fprintf(stderr, "Error: list file '%s' does not exist\n", listPath.c_str());
+		return false;
+	}
+
+	size_t lineNum = 0;
+	for (std::string line : File::ReadAllLines(listPath))
+	{
+		lineNum++;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+
+		size_t first = line.find_first_not_of(" \t");
+		if (first == std::string::npos || line[first] == '#')
+			continue;
+
+		std::vector<std::string> columns = StringHelper::Split(line, "\t");
+		for (std::string& column : columns)
+		{
+			size_t start = column.find_first_not_of(' ');
+			size_t end = column.find_last_not_of(' ');
+			column = start == std::string::npos ? "" : column.substr(start, end - start + 1);
+		}
+		bool emptyColumn = std::any_of(columns.begin(), columns.end(),
+		                               [](const std::string& column) { return column.empty(); });
+
+		if (columns.size() > maxColumns || columns.size() < minColumns || emptyColumn)
+		{
+			fprintf(stderr, "Error: %s:%zu: expected '%s', separated by tabs\n", listPath.c_str(),
+			        lineNum, lineFormat);
+			return false;
+		}
+
+		entries.push_back(std::move(columns));
+	}
+
+	return true;
+}
+
+/**
+ * Runs `jobCount` jobs on up to `threadCount` threads (the calling one included). Every thread
+ * pulls the next pending job as soon as it is done with the previous one, so a big job doesn't
+ * keep a thread busy while the others have finished their share. No new job is started once one
+ * of them has failed.
+ */
+bool RunListJobs(size_t jobCount, size_t threadCount, const std::function<bool(size_t)>& runJob)
+{
+	std::atomic<size_t> nextJob = 0;
+	std::atomic<bool> failed = false;
+	auto worker = [&]() {
+		while (!failed)
+		{
+			size_t jobIndex = nextJob++;
+			if (jobIndex >= jobCount)
+				break;
+
+			if (!runJob(jobIndex))
+				failed = true;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < std::min(threadCount, jobCount); i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return !failed;
+}
+
+/**
+ * Reads a list of XMLs to extract. Each non-empty line has the form
+ * `<xml path>\t<output path>[\t<source output path>]`; lines starting with `#` are ignored.
+ */
+bool ReadExtractionList(const fs::path& listPath, std::vector<ExtractionJob>& jobs)
+{
+	std::vector<std::vector<std::string>> entries;
+
+	if (!ReadListFile(listPath, 2, 3, "<xml path> <output path> [<source output path>]", entries))
+		return false;
+
+	for (const auto& columns : entries)
+	{
+		ExtractionJob job;
+		job.xmlPath = columns[0];
+		job.outputPath = columns[1];
+		job.sourceOutputPath = columns.size() > 2 ? columns[2] : columns[1];
+		jobs.push_back(job);
+	}
+
+	return true;
+}
+
+/**
+ * Extracts a single XML of an extraction list, using its own context so it can run in parallel
+ * with other jobs.
+ */
+bool ExtractListJob(Globals* sharedContext, const ExtractionJob& job, ZFileMode fileMode)
+{
+	Globals jobContext(sharedContext);
+
+	jobContext.inputPath = job.xmlPath;
+	jobContext.outputPath = job.outputPath;
+	jobContext.sourceOutputPath = job.sourceOutputPath;
+
+	if (jobContext.verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Extracting '%s'\n", job.xmlPath.c_str());
+
+	try
+	{
+		return ParseCached(job.xmlPath, fileMode);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "%s\n", e.what());
+		fprintf(stderr, "Error when extracting '%s'\n", job.xmlPath.c_str());
+		return false;
+	}
+}
+
+/**
+ * Extracts every XML of the list passed with `-il` in this process, on up to `-j` threads. The
+ * config, the symbol map and the external files of the config are loaded only once and shared by
+ * every job, while the files of each XML are unloaded as soon as it has been extracted.
+ */
+int HandleExtractList(ZFileMode fileMode)
+{
+	std::vector<ExtractionJob> jobs;
+
+	if (!ReadExtractionList(Globals::Instance->inputListPath, jobs))
+		return 1;
+
+	Globals* sharedContext = Globals::Instance;
+	size_t threadCount = std::max<uint32_t>(sharedContext->jobCount, 1);
+
+	// Exporters may keep their own state between files, so don't run them in parallel.
+	if (sharedContext->GetExporterSet() != nullptr)
+		threadCount = 1;
+
+	bool success = RunListJobs(jobs.size(), threadCount, [&](size_t jobIndex) {
+		return ExtractListJob(sharedContext, jobs[jobIndex], fileMode);
+	});
+
+	return success ? 0 : 1;
+}
+
+/**
+ * Reads a list of PNGs to convert. Each non-empty line has the form
+ * `<png path>\t<output path>[\t<texture type>]`; lines starting with `#` are ignored. If the
+ * texture type is omitted, it is taken from the name of the PNG (`name.<texture type>.png`).
+ * Lines that only differ by their output path (as the duplicates of a `--dedup-textures` manifest
+ * do) are merged into a single job, so the PNG is only converted once.
+ */
+bool ReadTextureBuildList(const fs::path& listPath, std::vector<TextureBuildJob>& jobs)
+{
+	std::vector<std::vector<std::string>> entries;
+	std::map<std::tuple<fs::path, TextureType, bool>, size_t> jobIndices;
+
+	if (!ReadListFile(listPath, 2, 3, "<png path> <output path> [<texture type>]", entries))
+		return false;
+
+	for (const auto& columns : entries)
+	{
+		fs::path pngPath = columns[0];
+		fs::path outPath = columns[1];
+
+		std::string texTypeStr;
+		if (columns.size() > 2)
+			texTypeStr = columns[2];
+		else if (pngPath.stem().has_extension())
+			texTypeStr = pngPath.stem().extension().string().substr(1);
+
+		TextureType texType = ZTexture::GetTextureTypeFromString(texTypeStr);
+		bool dWordAligned = outPath.stem().string().find("u32") == std::string::npos;
+		auto [it, inserted] =
+			jobIndices.try_emplace({pngPath, texType, dWordAligned}, jobs.size());
+
+		if (inserted)
+			jobs.push_back({pngPath, {}, texType});
+
+		std::vector<fs::path>& outPaths = jobs[it->second].outPaths;
+		if (std::find(outPaths.begin(), outPaths.end(), outPath) == outPaths.end())
+			outPaths.push_back(outPath);
+	}
+
+	return true;
+}
+
+bool BuildTextureListJob(Globals* sharedContext, const TextureBuildJob& job)
+{
+	Globals jobContext(sharedContext);
+
+	jobContext.inputPath = job.pngPath;
+	jobContext.outputPath = job.outPaths[0];
+	jobContext.texType = job.texType;
+
+	if (jobContext.verbosity >= VerbosityLevel::VERBOSITY_INFO)
+		printf("Building texture '%s'\n", job.pngPath.c_str());
+
+	try
+	{
+		BuildAssetTexture(job.pngPath, job.texType, job.outPaths, true);
+		return true;
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "%s\n", e.what());
+		fprintf(stderr, "Error when building texture '%s'\n", job.pngPath.c_str());
+		return false;
+	}
+}
+
+/**
+ * Converts every PNG of the list passed with `-il` in this process, on up to `-j` threads, so a
+ * build doesn't have to start a ZAPD process (and initialize it) once per texture.
+ */
+int HandleBuildTextureList()
+{
+	std::vector<TextureBuildJob> jobs;
+
+	if (!ReadTextureBuildList(Globals::Instance->inputListPath, jobs))
+		return 1;
+
+	Globals* sharedContext = Globals::Instance;
+	size_t threadCount = std::max<uint32_t>(sharedContext->jobCount, 1);
+
+	bool success = RunListJobs(jobs.size(), threadCount, [&](size_t jobIndex) {
+		return BuildTextureListJob(sharedContext, jobs[jobIndex]);
+	});
+
+	return success ? 0 : 1;
 }
 
-void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const fs::path& outPath)
+// The outputs of a batch are only rewritten if they changed, since the batch stamp is what make
+// compares against. A single output is the make target itself, so it is always written.
+void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType,
+                       const std::vector<fs::path>& outPaths, bool onlyIfChanged)
 {
-	std::string name = outPath.stem().string();
+	ProfileScope profileScope("BuildTexture");
+	std::string name = outPaths[0].stem().string();
 
 	ZTexture tex(nullptr);
 
@@ -444,7 +863,13 @@ void BuildAssetTexture(const fs::path& pngFilePath, TextureType texType, const f
 
 	std::string src = tex.GetBodySourceCode();
 
-	File::WriteAllText(outPath.string(), src);
+	for (const fs::path& outPath : outPaths)
+	{
+		if (onlyIfChanged)
+			File::WriteAllTextIfChanged(outPath, src);
+		else
+			File::WriteAllText(outPath, src);
+	}
 }
 
 void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath)
@@ -452,7 +877,7 @@ void BuildAssetBackground(const fs::path& imageFilePath, const fs::path& outPath
 	ZBackground background(nullptr);
 	background.ParseBinaryFile(imageFilePath.string(), false);
 
-	File::WriteAllText(outPath.string(), background.GetBodySourceCode());
+	File::WriteAllText(outPath, background.GetBodySourceCode());
 }
 
 void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath)
@@ -462,7 +887,7 @@ void BuildAssetBlob(const fs::path& blobFilePath, const fs::path& outPath)
 
 	std::string src = blob->GetBodySourceCode();
 
-	File::WriteAllText(outPath.string(), src);
+	File::WriteAllText(outPath, src);
 
 	delete blob;
 }
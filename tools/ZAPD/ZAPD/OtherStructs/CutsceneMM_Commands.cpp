@@ -26,7 +26,7 @@ const std::unordered_map<CutsceneMMCommands, CsCommandListDescriptor> csCommands
 };
 
 CutsceneSubCommandEntry_GenericMMCmd::CutsceneSubCommandEntry_GenericMMCmd(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex, CutsceneMMCommands cmdId)
+	ByteSpan rawData, offset_t rawDataIndex, CutsceneMMCommands cmdId)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex), commandId(cmdId)
 {
 }
@@ -45,7 +45,7 @@ std::string CutsceneSubCommandEntry_GenericMMCmd::GetBodySourceCode() const
 	return StringHelper::Sprintf(entryFmt.c_str(), base, startFrame, endFrame, pad);
 }
 
-CutsceneMMCommand_GenericCmd::CutsceneMMCommand_GenericCmd(const std::vector<uint8_t>& rawData,
+CutsceneMMCommand_GenericCmd::CutsceneMMCommand_GenericCmd(ByteSpan rawData,
                                                            offset_t rawDataIndex,
                                                            CutsceneMMCommands cmdId)
 	: CutsceneCommand(rawData, rawDataIndex)
@@ -75,7 +75,7 @@ std::string CutsceneMMCommand_GenericCmd::GetCommandMacro() const
 	return StringHelper::Sprintf("CS_UNK_DATA_LIST(0x%X, %i)", commandID, numEntries);
 }
 
-CutsceneSubCommandEntry_Camera::CutsceneSubCommandEntry_Camera(const std::vector<uint8_t>& rawData,
+CutsceneSubCommandEntry_Camera::CutsceneSubCommandEntry_Camera(ByteSpan rawData,
                                                                offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
@@ -91,7 +91,7 @@ size_t CutsceneSubCommandEntry_Camera::GetRawSize() const
 	return 0x04;
 }
 
-CutsceneMMCommand_Camera::CutsceneMMCommand_Camera(const std::vector<uint8_t>& rawData,
+CutsceneMMCommand_Camera::CutsceneMMCommand_Camera(ByteSpan rawData,
                                                    offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -112,7 +112,7 @@ std::string CutsceneMMCommand_Camera::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_FadeScreen::CutsceneSubCommandEntry_FadeScreen(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	unk_06 = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0x06);
@@ -134,7 +134,7 @@ size_t CutsceneSubCommandEntry_FadeScreen::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneMMCommand_FadeScreen::CutsceneMMCommand_FadeScreen(const std::vector<uint8_t>& rawData,
+CutsceneMMCommand_FadeScreen::CutsceneMMCommand_FadeScreen(ByteSpan rawData,
                                                            offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -155,7 +155,7 @@ std::string CutsceneMMCommand_FadeScreen::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_FadeSeq::CutsceneSubCommandEntry_FadeSeq(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	unk_08 = BitConverter::ToUInt32BE(rawData, rawDataIndex + 8);
@@ -171,7 +171,7 @@ size_t CutsceneSubCommandEntry_FadeSeq::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneMMCommand_FadeSeq::CutsceneMMCommand_FadeSeq(const std::vector<uint8_t>& rawData,
+CutsceneMMCommand_FadeSeq::CutsceneMMCommand_FadeSeq(ByteSpan rawData,
                                                      offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -192,13 +192,13 @@ std::string CutsceneMMCommand_FadeSeq::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_NonImplemented::CutsceneSubCommandEntry_NonImplemented(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 }
 
 CutsceneMMCommand_NonImplemented::CutsceneMMCommand_NonImplemented(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
 	rawDataIndex += 4;
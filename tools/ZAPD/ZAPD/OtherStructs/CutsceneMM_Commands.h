@@ -44,7 +44,7 @@ class CutsceneSubCommandEntry_GenericMMCmd : public CutsceneSubCommandEntry
 public:
 	CutsceneMMCommands commandId;
 
-	CutsceneSubCommandEntry_GenericMMCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneSubCommandEntry_GenericMMCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                                     CutsceneMMCommands cmdId);
 
 	std::string GetBodySourceCode() const override;
@@ -53,7 +53,7 @@ public:
 class CutsceneMMCommand_GenericCmd : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneMMCommand_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                             CutsceneMMCommands cmdId);
 
 	std::string GetCommandMacro() const override;
@@ -66,7 +66,7 @@ class CutsceneSubCommandEntry_Camera : public CutsceneSubCommandEntry
 public:
 	uint32_t unk_08;
 
-	CutsceneSubCommandEntry_Camera(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_Camera(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -76,7 +76,7 @@ public:
 class CutsceneMMCommand_Camera : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_Camera(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_Camera(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -91,7 +91,7 @@ public:
 	uint8_t unk_0A;
 	uint8_t unk_0B;
 
-	CutsceneSubCommandEntry_FadeScreen(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_FadeScreen(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -101,7 +101,7 @@ public:
 class CutsceneMMCommand_FadeScreen : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_FadeScreen(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_FadeScreen(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -111,7 +111,7 @@ class CutsceneSubCommandEntry_FadeSeq : public CutsceneSubCommandEntry
 public:
 	uint32_t unk_08;
 
-	CutsceneSubCommandEntry_FadeSeq(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_FadeSeq(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -121,7 +121,7 @@ public:
 class CutsceneMMCommand_FadeSeq : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_FadeSeq(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_FadeSeq(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -129,12 +129,12 @@ public:
 class CutsceneSubCommandEntry_NonImplemented : public CutsceneSubCommandEntry
 {
 public:
-	CutsceneSubCommandEntry_NonImplemented(const std::vector<uint8_t>& rawData,
+	CutsceneSubCommandEntry_NonImplemented(ByteSpan rawData,
 	                                       offset_t rawDataIndex);
 };
 
 class CutsceneMMCommand_NonImplemented : public CutsceneCommand
 {
 public:
-	CutsceneMMCommand_NonImplemented(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneMMCommand_NonImplemented(ByteSpan rawData, offset_t rawDataIndex);
 };
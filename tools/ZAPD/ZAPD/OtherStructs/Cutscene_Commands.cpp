@@ -10,7 +10,7 @@
 
 /* CutsceneSubCommandEntry */
 
-CutsceneSubCommandEntry::CutsceneSubCommandEntry(const std::vector<uint8_t>& rawData,
+CutsceneSubCommandEntry::CutsceneSubCommandEntry(ByteSpan rawData,
                                                  offset_t rawDataIndex)
 {
 	base = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
@@ -32,7 +32,7 @@ size_t CutsceneSubCommandEntry::GetRawSize() const
 
 /* CutsceneCommand */
 
-CutsceneCommand::CutsceneCommand(const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+CutsceneCommand::CutsceneCommand(ByteSpan rawData, offset_t rawDataIndex)
 {
 	numEntries = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0);
 }
@@ -103,7 +103,7 @@ const std::unordered_map<CutsceneCommands, CsCommandListDescriptor> csCommandsDe
 };
 
 CutsceneSubCommandEntry_GenericCmd::CutsceneSubCommandEntry_GenericCmd(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex, CutsceneCommands cmdId)
+	ByteSpan rawData, offset_t rawDataIndex, CutsceneCommands cmdId)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex), commandId(cmdId)
 {
 	word0 = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0x0);
@@ -146,7 +146,7 @@ size_t CutsceneSubCommandEntry_GenericCmd::GetRawSize() const
 	return 0x30;
 }
 
-CutsceneCommand_GenericCmd::CutsceneCommand_GenericCmd(const std::vector<uint8_t>& rawData,
+CutsceneCommand_GenericCmd::CutsceneCommand_GenericCmd(ByteSpan rawData,
                                                        offset_t rawDataIndex,
                                                        CutsceneCommands cmdId)
 	: CutsceneCommand(rawData, rawDataIndex)
@@ -176,7 +176,7 @@ std::string CutsceneCommand_GenericCmd::GetCommandMacro() const
 	return StringHelper::Sprintf("CS_UNK_DATA_LIST(0x%X, %i)", commandID, numEntries);
 }
 
-CutsceneCameraPoint::CutsceneCameraPoint(const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+CutsceneCameraPoint::CutsceneCameraPoint(ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	continueFlag = BitConverter::ToInt8BE(rawData, rawDataIndex + 0);
@@ -227,7 +227,7 @@ size_t CutsceneCameraPoint::GetRawSize() const
 	return 0x10;
 }
 
-CutsceneCommandSetCameraPos::CutsceneCommandSetCameraPos(const std::vector<uint8_t>& rawData,
+CutsceneCommandSetCameraPos::CutsceneCommandSetCameraPos(ByteSpan rawData,
                                                          offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -285,7 +285,7 @@ size_t CutsceneCommandSetCameraPos::GetCommandSize() const
 	return 0x0C + entries.at(0)->GetRawSize() * entries.size();
 }
 
-CutsceneSubCommandEntry_Rumble::CutsceneSubCommandEntry_Rumble(const std::vector<uint8_t>& rawData,
+CutsceneSubCommandEntry_Rumble::CutsceneSubCommandEntry_Rumble(ByteSpan rawData,
                                                                offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
@@ -315,7 +315,7 @@ size_t CutsceneSubCommandEntry_Rumble::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneCommand_Rumble::CutsceneCommand_Rumble(const std::vector<uint8_t>& rawData,
+CutsceneCommand_Rumble::CutsceneCommand_Rumble(ByteSpan rawData,
                                                offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -340,7 +340,7 @@ std::string CutsceneCommand_Rumble::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_SetTime::CutsceneSubCommandEntry_SetTime(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	hour = BitConverter::ToUInt8BE(rawData, rawDataIndex + 6);
@@ -359,7 +359,7 @@ size_t CutsceneSubCommandEntry_SetTime::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneCommand_SetTime::CutsceneCommand_SetTime(const std::vector<uint8_t>& rawData,
+CutsceneCommand_SetTime::CutsceneCommand_SetTime(ByteSpan rawData,
                                                  offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -380,7 +380,7 @@ std::string CutsceneCommand_SetTime::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_TextBox::CutsceneSubCommandEntry_TextBox(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	type = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x6);
@@ -435,7 +435,7 @@ size_t CutsceneSubCommandEntry_TextBox::GetRawSize() const
 	return 0x0C;
 }
 
-CutsceneCommand_TextBox::CutsceneCommand_TextBox(const std::vector<uint8_t>& rawData,
+CutsceneCommand_TextBox::CutsceneCommand_TextBox(ByteSpan rawData,
                                                  offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -456,7 +456,7 @@ std::string CutsceneCommand_TextBox::GetCommandMacro() const
 }
 
 CutsceneSubCommandEntry_ActorAction::CutsceneSubCommandEntry_ActorAction(
-	const std::vector<uint8_t>& rawData, offset_t rawDataIndex)
+	ByteSpan rawData, offset_t rawDataIndex)
 	: CutsceneSubCommandEntry(rawData, rawDataIndex)
 {
 	rotX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0x6);
@@ -514,7 +514,7 @@ size_t CutsceneSubCommandEntry_ActorAction::GetRawSize() const
 	return 0x30;
 }
 
-CutsceneCommand_ActorAction::CutsceneCommand_ActorAction(const std::vector<uint8_t>& rawData,
+CutsceneCommand_ActorAction::CutsceneCommand_ActorAction(ByteSpan rawData,
                                                          offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -548,7 +548,7 @@ std::string CutsceneCommand_ActorAction::GetCommandMacro() const
 	return StringHelper::Sprintf("CS_NPC_ACTION_LIST(0x%03X, %i)", commandID, entries.size());
 }
 
-CutsceneCommand_Terminator::CutsceneCommand_Terminator(const std::vector<uint8_t>& rawData,
+CutsceneCommand_Terminator::CutsceneCommand_Terminator(ByteSpan rawData,
                                                        offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -574,7 +574,7 @@ size_t CutsceneCommand_Terminator::GetCommandSize() const
 	return 0x10;
 }
 
-CutsceneCommandSceneTransFX::CutsceneCommandSceneTransFX(const std::vector<uint8_t>& rawData,
+CutsceneCommandSceneTransFX::CutsceneCommandSceneTransFX(ByteSpan rawData,
                                                          offset_t rawDataIndex)
 	: CutsceneCommand(rawData, rawDataIndex)
 {
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "Declaration.h"
+#include "Utils/ByteSpan.h"
 
 enum class CutsceneCommands
 {
@@ -53,7 +54,7 @@ public:
 
 	uint32_t commandID;
 
-	CutsceneSubCommandEntry(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry(ByteSpan rawData, offset_t rawDataIndex);
 	virtual ~CutsceneSubCommandEntry() = default;
 
 	virtual std::string GetBodySourceCode() const;
@@ -70,7 +71,7 @@ public:
 	uint32_t numEntries;
 	std::vector<CutsceneSubCommandEntry*> entries;
 
-	CutsceneCommand(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand(ByteSpan rawData, offset_t rawDataIndex);
 	virtual ~CutsceneCommand();
 
 	virtual std::string GetCommandMacro() const;
@@ -99,7 +100,7 @@ public:
 	uint32_t unused9 = 0;
 	uint32_t unused10 = 0;
 
-	CutsceneSubCommandEntry_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneSubCommandEntry_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                                   CutsceneCommands cmdId);
 
 	std::string GetBodySourceCode() const override;
@@ -110,7 +111,7 @@ public:
 class CutsceneCommand_GenericCmd : public CutsceneCommand
 {
 public:
-	CutsceneCommand_GenericCmd(const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+	CutsceneCommand_GenericCmd(ByteSpan rawData, offset_t rawDataIndex,
 	                           CutsceneCommands cmdId);
 
 	std::string GetCommandMacro() const override;
@@ -126,7 +127,7 @@ public:
 	int16_t posX, posY, posZ;
 	int16_t unused;
 
-	CutsceneCameraPoint(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCameraPoint(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -141,7 +142,7 @@ public:
 	uint16_t endFrame;
 	uint16_t unused;
 
-	CutsceneCommandSetCameraPos(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommandSetCameraPos(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 
@@ -155,7 +156,7 @@ public:
 	uint16_t startFrame;
 	uint16_t endFrame;
 
-	CutsceneCommandSceneTransFX(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommandSceneTransFX(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GenerateSourceCode() const override;
 	size_t GetCommandSize() const override;
@@ -171,7 +172,7 @@ public:
 	uint8_t unk_0A;
 	uint8_t unk_0B;
 
-	CutsceneSubCommandEntry_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -181,7 +182,7 @@ public:
 class CutsceneCommand_Rumble : public CutsceneCommand
 {
 public:
-	CutsceneCommand_Rumble(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_Rumble(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -193,7 +194,7 @@ public:
 	uint8_t minute;
 	uint32_t unk_08;
 
-	CutsceneSubCommandEntry_SetTime(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_SetTime(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -203,7 +204,7 @@ public:
 class CutsceneCommand_SetTime : public CutsceneCommand
 {
 public:
-	CutsceneCommand_SetTime(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_SetTime(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -215,7 +216,7 @@ public:
 	uint16_t textId1;
 	uint16_t textId2;
 
-	CutsceneSubCommandEntry_TextBox(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_TextBox(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetBodySourceCode() const override;
 
@@ -225,7 +226,7 @@ public:
 class CutsceneCommand_TextBox : public CutsceneCommand
 {
 public:
-	CutsceneCommand_TextBox(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_TextBox(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -238,7 +239,7 @@ public:
 	int32_t endPosX, endPosY, endPosZ;
 	float normalX, normalY, normalZ;
 
-	CutsceneSubCommandEntry_ActorAction(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneSubCommandEntry_ActorAction(ByteSpan rawData, offset_t rawDataIndex);
 	std::string GetBodySourceCode() const override;
 
 	size_t GetRawSize() const override;
@@ -247,7 +248,7 @@ public:
 class CutsceneCommand_ActorAction : public CutsceneCommand
 {
 public:
-	CutsceneCommand_ActorAction(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_ActorAction(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GetCommandMacro() const override;
 };
@@ -260,7 +261,7 @@ public:
 	uint16_t endFrame;
 	uint16_t unknown;
 
-	CutsceneCommand_Terminator(const std::vector<uint8_t>& rawData, offset_t rawDataIndex);
+	CutsceneCommand_Terminator(ByteSpan rawData, offset_t rawDataIndex);
 
 	std::string GenerateSourceCode() const override;
 	size_t GetCommandSize() const override;
@@ -0,0 +1,267 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Globals.h"
+#include "Utils/File.h"
+#include "Utils/StringHelper.h"
+#include "ZResource.h"
+
+namespace
+{
+struct ProfileEvent
+{
+	const char* phase;
+	uint32_t resourceTypeIndex;
+	uint32_t fileIndex;
+	uint32_t threadIndex;
+	int64_t start;  // In microseconds since the profiler was enabled
+	int64_t duration;
+	int64_t selfDuration;
+};
+
+struct ProfileStats
+{
+	uint64_t count = 0;
+	int64_t duration = 0;
+	int64_t selfDuration = 0;
+};
+
+std::chrono::steady_clock::time_point sStartTime;
+std::mutex sEventsMutex;
+std::vector<ProfileEvent> sEvents;
+
+// Resource types and file names are stored once, the events only keep their index.
+std::vector<std::string> sStrings;
+std::unordered_map<std::string, uint32_t> sStringIndices;
+
+std::atomic<uint32_t> sThreadCount = 0;
+thread_local uint32_t sThreadIndex = sThreadCount++;
+thread_local ProfileScope* sCurrentScope = nullptr;
+
+const char* const sCounterNames[] = {
+	"DListCacheHits",
+	"DListCacheMisses",
+};
+static_assert(std::size(sCounterNames) == static_cast<size_t>(ProfileCounter::Count));
+
+std::atomic<uint64_t> sCounters[static_cast<size_t>(ProfileCounter::Count)];
+
+uint32_t GetStringIndex(const std::string& str)
+{
+	auto it = sStringIndices.find(str);
+	if (it != sStringIndices.end())
+		return it->second;
+
+	sStrings.push_back(str);
+	sStringIndices[str] = sStrings.size() - 1;
+	return sStrings.size() - 1;
+}
+
+std::string EscapeJson(const std::string& str)
+{
+	std::string escaped;
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+
+		if (static_cast<uint8_t>(c) < 0x20)
+			StringHelper::AppendFormat(escaped, "\\u%04X", c);
+		else
+			escaped += c;
+	}
+
+	return escaped;
+}
+
+void AppendStats(std::string& output, const char* listName, const char* keyName,
+                 const std::map<std::pair<std::string, std::string>, ProfileStats>& statsMap)
+{
+	std::vector<std::pair<std::pair<std::string, std::string>, ProfileStats>> sortedStats(
+		statsMap.begin(), statsMap.end());
+
+	std::stable_sort(sortedStats.begin(), sortedStats.end(), [](const auto& a, const auto& b) {
+		return a.second.selfDuration > b.second.selfDuration;
+	});
+
+	StringHelper::AppendFormat(output, "\t\"%s\": [", listName);
+
+	for (size_t i = 0; i < sortedStats.size(); i++)
+	{
+		const auto& [key, stats] = sortedStats[i];
+
+		output += i == 0 ? "\n" : ",\n";
+		output += "\t\t{ ";
+		if (keyName != nullptr)
+			StringHelper::AppendFormat(output, "\"%s\": \"%s\", ", keyName,
+			                           EscapeJson(key.first).c_str());
+		StringHelper::AppendFormat(
+			output, "\"phase\": \"%s\", \"count\": %llu, \"totalMs\": %.3f, \"selfMs\": %.3f }",
+			key.second.c_str(), (unsigned long long)stats.count, stats.duration / 1000.0,
+			stats.selfDuration / 1000.0);
+	}
+
+	output += "\n\t]";
+}
+}
+
+bool Profiler::enabled = false;
+
+void Profiler::Enable()
+{
+	sStartTime = std::chrono::steady_clock::now();
+	enabled = true;
+}
+
+bool Profiler::IsEnabled()
+{
+	return enabled;
+}
+
+void Profiler::WriteReport(const fs::path& reportPath)
+{
+	std::map<std::pair<std::string, std::string>, ProfileStats> phaseStats;
+	std::map<std::pair<std::string, std::string>, ProfileStats> resourceTypeStats;
+	std::map<std::pair<std::string, std::string>, ProfileStats> fileStats;
+	std::lock_guard<std::mutex> lock(sEventsMutex);
+
+	for (const ProfileEvent& event : sEvents)
+	{
+		ProfileStats* eventStats[] = {
+			&phaseStats[{"", event.phase}],
+			&resourceTypeStats[{sStrings[event.resourceTypeIndex], event.phase}],
+			&fileStats[{sStrings[event.fileIndex], event.phase}],
+		};
+
+		for (ProfileStats* stats : eventStats)
+		{
+			stats->count++;
+			stats->duration += event.duration;
+			stats->selfDuration += event.selfDuration;
+		}
+	}
+
+	// Events that didn't work on a resource have no type
+	for (auto it = resourceTypeStats.begin(); it != resourceTypeStats.end();)
+		it = it->first.first == "" ? resourceTypeStats.erase(it) : std::next(it);
+
+	std::string report = "{\n";
+	StringHelper::AppendFormat(report, "\t\"wallMs\": %.3f,\n", GetTimestamp() / 1000.0);
+	StringHelper::AppendFormat(report, "\t\"threads\": %u,\n", sThreadCount.load());
+	report += "\t\"counters\": {";
+	for (size_t i = 0; i < std::size(sCounters); i++)
+	{
+		report += i == 0 ? "\n" : ",\n";
+		StringHelper::AppendFormat(report, "\t\t\"%s\": %llu", sCounterNames[i],
+		                           (unsigned long long)sCounters[i].load());
+	}
+	report += "\n\t},\n";
+	AppendStats(report, "phases", nullptr, phaseStats);
+	report += ",\n";
+	AppendStats(report, "resourceTypes", "resourceType", resourceTypeStats);
+	report += ",\n";
+	AppendStats(report, "files", "file", fileStats);
+	report += "\n}\n";
+
+	File::WriteAllText(reportPath, report);
+}
+
+void Profiler::WriteTrace(const fs::path& tracePath)
+{
+	std::lock_guard<std::mutex> lock(sEventsMutex);
+	std::string trace;
+
+	trace.reserve(sEvents.size() * 160);
+	trace += "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+	for (size_t i = 0; i < sEvents.size(); i++)
+	{
+		const ProfileEvent& event = sEvents[i];
+		const std::string& resourceType = sStrings[event.resourceTypeIndex];
+
+		trace += i == 0 ? "\n" : ",\n";
+		StringHelper::AppendFormat(
+			trace,
+			"{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %lld, \"dur\": %lld, "
+			"\"pid\": 0, \"tid\": %u, \"args\": {\"file\": \"%s\"",
+			event.phase, resourceType == "" ? "zapd" : resourceType.c_str(),
+			(long long)event.start, (long long)event.duration, event.threadIndex,
+			EscapeJson(sStrings[event.fileIndex]).c_str());
+		if (resourceType != "")
+			StringHelper::AppendFormat(trace, ", \"resourceType\": \"%s\"", resourceType.c_str());
+		trace += "}}";
+	}
+
+	trace += "\n]}\n";
+
+	File::WriteAllText(tracePath, trace);
+}
+
+void Profiler::IncrementCounter(ProfileCounter counter)
+{
+	if (!enabled)
+		return;
+
+	sCounters[static_cast<size_t>(counter)].fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t Profiler::GetTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			   std::chrono::steady_clock::now() - sStartTime)
+		.count();
+}
+
+void Profiler::AddEvent(const char* phase, const std::string& resourceType, int64_t start,
+                        int64_t duration, int64_t selfDuration)
+{
+	std::string fileName;
+
+	if (Globals::Instance != nullptr)
+		fileName = Globals::Instance->inputPath.string();
+
+	std::lock_guard<std::mutex> lock(sEventsMutex);
+
+	sEvents.push_back({phase, GetStringIndex(resourceType), GetStringIndex(fileName), sThreadIndex,
+	                   start, duration, selfDuration});
+}
+
+ProfileScope::ProfileScope(const char* nPhase)
+{
+	if (!Profiler::enabled)
+		return;
+
+	phase = nPhase;
+	parentScope = sCurrentScope;
+	sCurrentScope = this;
+	start = Profiler::GetTimestamp();
+}
+
+ProfileScope::ProfileScope(const char* nPhase, const ZResource* res) : ProfileScope(nPhase)
+{
+	if (phase != nullptr)
+		resourceType = GetResourceTypeName(res->GetResourceType());
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (phase == nullptr)
+		return;
+
+	int64_t duration = Profiler::GetTimestamp() - start;
+
+	sCurrentScope = parentScope;
+	if (parentScope != nullptr)
+		parentScope->childrenDuration += duration;
+
+	Profiler::AddEvent(phase, resourceType, start, duration, duration - childrenDuration);
+}
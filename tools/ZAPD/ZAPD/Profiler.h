@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Utils/Directory.h"
+
+class ZResource;
+
+// The events too frequent to be timed one by one, which the report only counts
+enum class ProfileCounter
+{
+	DListCacheHits,
+	DListCacheMisses,
+	Count,
+};
+
+/**
+ * Timings of the phases of a ZAPD run, enabled with `--profile-report` and `--profile-trace`.
+ *
+ * Every `ProfileScope` records one event, tagged with its phase, the resource type it worked on (if
+ * any) and the input file of the context of its thread, so the events of every job thread of a
+ * list extraction end up in the same report. Scopes nest: the self time of an event is its
+ * duration minus the duration of the scopes opened inside it on the same thread.
+ */
+class Profiler
+{
+public:
+	static void Enable();
+	static bool IsEnabled();
+
+	// Times aggregated per phase, per resource type and per input file, and the counters.
+	static void WriteReport(const fs::path& reportPath);
+	// Every event, in the Chrome trace event format (chrome://tracing, Perfetto...).
+	static void WriteTrace(const fs::path& tracePath);
+
+	// Adds one to `counter`. Lock-free, so it can be called from hot paths on every thread.
+	static void IncrementCounter(ProfileCounter counter);
+
+protected:
+	friend class ProfileScope;
+
+	static bool enabled;
+
+	static int64_t GetTimestamp();
+	static void AddEvent(const char* phase, const std::string& resourceType, int64_t start,
+	                     int64_t duration, int64_t selfDuration);
+};
+
+/**
+ * Times the rest of the enclosing block as a `phase` event. Does nothing unless the profiler was
+ * enabled, so it is cheap enough to be left in hot paths.
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* nPhase);
+	ProfileScope(const char* nPhase, const ZResource* res);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+protected:
+	const char* phase = nullptr;
+	const char* resourceType = "";
+	int64_t start = 0;
+	int64_t childrenDuration = 0;
+	ProfileScope* parentScope = nullptr;
+};
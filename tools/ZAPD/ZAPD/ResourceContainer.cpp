@@ -0,0 +1,132 @@
+#include "ResourceContainer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "Globals.h"
+#include "Utils/File.h"
+#include "ZFile.h"
+
+namespace
+{
+void PutUInt16LE(std::vector<uint8_t>& data, size_t offset, uint16_t value)
+{
+	data[offset + 0] = value & 0xFF;
+	data[offset + 1] = value >> 8;
+}
+
+void PutUInt32LE(std::vector<uint8_t>& data, size_t offset, uint32_t value)
+{
+	for (size_t i = 0; i < 4; i++)
+		data[offset + i] = (value >> (i * 8)) & 0xFF;
+}
+
+size_t AlignSection(size_t offset)
+{
+	return (offset + ResourceContainer::sectionAlignment - 1) &
+	       ~(size_t)(ResourceContainer::sectionAlignment - 1);
+}
+
+void ImportResourceContainerExporter()
+{
+	ExporterSet* exporterSet = new ExporterSet();
+	exporterSet->endFileFunc = ResourceContainer::Write;
+
+	Globals::AddExporter("ZRES", exporterSet);
+}
+}
+
+REGISTER_EXPORTER(ImportResourceContainerExporter);
+
+std::vector<uint8_t> ResourceContainer::Build(ZFile* file)
+{
+	std::vector<ZResource*> resources = file->resources;
+	std::stable_sort(resources.begin(), resources.end(),
+	                 [](ZResource* a, ZResource* b) { return a->GetName() < b->GetName(); });
+
+	// The C types are shared by many resources, so they are only stored once
+	std::string names;
+	std::vector<uint32_t> nameOffsets;
+	std::vector<uint32_t> typeNameOffsets;
+	std::map<std::string, uint32_t> typeNames;
+
+	for (ZResource* res : resources)
+	{
+		nameOffsets.push_back(names.size());
+		names += res->GetName();
+		names += '\0';
+
+		auto [it, inserted] = typeNames.try_emplace(res->GetSourceTypeName(), names.size());
+		if (inserted)
+		{
+			names += it->first;
+			names += '\0';
+		}
+		typeNameOffsets.push_back(it->second);
+	}
+
+	ByteSpan rawData = file->GetRawData();
+	size_t entriesOffset = sizeof(Header);
+	size_t namesOffset = entriesOffset + resources.size() * sizeof(Entry);
+	size_t containerSize = AlignSection(namesOffset + names.size());
+	std::vector<size_t> dataOffsets;
+	std::vector<size_t> dataSizes;
+
+	for (ZResource* res : resources)
+	{
+		offset_t rawDataIndex = res->GetRawDataIndex();
+		size_t dataSize = 0;
+
+		if (rawDataIndex < rawData.size())
+			dataSize = std::min(res->GetRawDataSize(), rawData.size() - rawDataIndex);
+
+		dataOffsets.push_back(containerSize);
+		dataSizes.push_back(dataSize);
+		containerSize = AlignSection(containerSize + dataSize);
+	}
+
+	std::vector<uint8_t> container(containerSize, 0);
+
+	std::memcpy(container.data(), magic, sizeof(magic));
+	PutUInt16LE(container, offsetof(Header, version), version);
+	PutUInt16LE(container, offsetof(Header, headerSize), sizeof(Header));
+	PutUInt32LE(container, offsetof(Header, entryCount), resources.size());
+	PutUInt32LE(container, offsetof(Header, entriesOffset), entriesOffset);
+	PutUInt32LE(container, offsetof(Header, namesOffset), namesOffset);
+	PutUInt32LE(container, offsetof(Header, namesSize), names.size());
+	PutUInt32LE(container, offsetof(Header, segment), file->segment);
+	PutUInt32LE(container, offsetof(Header, size), containerSize);
+
+	for (size_t i = 0; i < resources.size(); i++)
+	{
+		size_t entryOffset = entriesOffset + i * sizeof(Entry);
+
+		PutUInt32LE(container, entryOffset + offsetof(Entry, nameOffset), nameOffsets[i]);
+		PutUInt32LE(container, entryOffset + offsetof(Entry, typeNameOffset), typeNameOffsets[i]);
+		PutUInt32LE(container, entryOffset + offsetof(Entry, resourceType),
+		            static_cast<uint32_t>(resources[i]->GetResourceType()));
+		PutUInt32LE(container, entryOffset + offsetof(Entry, fileOffset),
+		            resources[i]->GetRawDataIndex());
+		PutUInt32LE(container, entryOffset + offsetof(Entry, dataOffset), dataOffsets[i]);
+		PutUInt32LE(container, entryOffset + offsetof(Entry, dataSize), dataSizes[i]);
+
+		if (dataSizes[i] > 0)
+			std::memcpy(container.data() + dataOffsets[i],
+			            rawData.data() + resources[i]->GetRawDataIndex(), dataSizes[i]);
+	}
+
+	std::memcpy(container.data() + namesOffset, names.data(), names.size());
+
+	return container;
+}
+
+void ResourceContainer::Write(ZFile* file)
+{
+	fs::path containerPath = Globals::Instance->outputPath / (file->GetName() + ".zres");
+
+	File::WriteAllBytesIfChanged(containerPath, Build(file));
+	Globals::Instance->outputFiles.push_back(containerPath);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class ZFile;
+
+/**
+ * Binary container of the resources extracted from a file, written as `<file name>.zres` in the
+ * output folder by the built-in `ZRES` exporter (`-se ZRES`).
+ *
+ * It is made to be memory mapped and used in place, without any parsing: every field is a
+ * little-endian integer at its natural alignment. The container is made of, in order:
+ *  - the `Header`,
+ *  - the table of `Entry`, one per resource, sorted by name so it can be binary searched,
+ *  - the names, NUL-terminated,
+ *  - the sections, each starting at a multiple of `sectionAlignment`: the raw data of every
+ *    resource, as found in the extracted file (big-endian).
+ * Readers should reject a container whose `version` they don't know.
+ */
+class ResourceContainer
+{
+public:
+	static constexpr char magic[4] = {'Z', 'R', 'E', 'S'};
+	static constexpr uint16_t version = 1;
+	static constexpr uint32_t sectionAlignment = 16;
+
+	struct Header
+	{
+		char magic[4];
+		uint16_t version;
+		uint16_t headerSize;  // sizeof(Header), fields may be added at the end in later versions
+		uint32_t entryCount;
+		uint32_t entriesOffset;
+		uint32_t namesOffset;
+		uint32_t namesSize;
+		uint32_t segment;  // Segment the file was extracted with, 0x80 for virtual addresses
+		uint32_t size;     // Of the whole container
+	};
+
+	struct Entry
+	{
+		uint32_t nameOffset;      // In the names
+		uint32_t typeNameOffset;  // In the names, C type of the resource (`Gfx`, `u64`...)
+		uint32_t resourceType;    // ZResourceType
+		uint32_t fileOffset;      // Offset of the resource in the extracted file
+		uint32_t dataOffset;      // From the start of the container
+		uint32_t dataSize;
+	};
+
+	static_assert(sizeof(Header) == 32, "the container layout can't depend on the compiler");
+	static_assert(sizeof(Entry) == 24, "the container layout can't depend on the compiler");
+
+	// Builds the container of every resource of `file`.
+	static std::vector<uint8_t> Build(ZFile* file);
+	// Writes the container of `file`, used as the `endFileFunc` of the `ZRES` exporter.
+	static void Write(ZFile* file);
+};
@@ -0,0 +1,151 @@
+#include "TextureDedupPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "CRC32.h"
+#include "Utils/File.h"
+#include "Utils/MappedFile.h"
+#include "Utils/StringHelper.h"
+#include "WarningHandler.h"
+
+namespace
+{
+// Where the bytes of a texture or TLUT are, since the pool outlives the files they are read from
+struct DataLocation
+{
+	fs::path filePath;
+	uint32_t offset = 0;
+	size_t size = 0;
+};
+
+struct PoolEntry
+{
+	DataLocation texture;
+	DataLocation tlut;
+	fs::path writtenPath;      // Where the PNG was written, by the first job to find the texture
+	std::set<fs::path> paths;  // Every path the texture would have been written to
+};
+
+std::mutex sPoolMutex;
+// Keyed by the settings and the CRC32s of the data, with an entry per texture of that key
+std::unordered_map<std::string, std::vector<PoolEntry>> sPool;
+
+uint32_t GetDataCrc(const TextureDedupData& data)
+{
+	return CRC32B(data.data.data(), data.data.size());
+}
+
+DataLocation GetDataLocation(const TextureDedupData& data)
+{
+	return {data.filePath, data.offset, data.data.size()};
+}
+
+// Compares the bytes at `location` with `data`, mapping the file of `location` again if needed
+bool HasSameData(const DataLocation& location, const TextureDedupData& data)
+{
+	if (location.size != data.data.size())
+		return false;
+
+	if (location.size == 0)
+		return true;
+
+	if (location.filePath == data.filePath && location.offset == data.offset)
+		return true;
+
+	MappedFile file;
+	if (!file.Open(location.filePath))
+		return false;
+
+	ByteSpan fileData = file.GetData();
+	if (location.offset + location.size > fileData.size())
+		return false;
+
+	return memcmp(fileData.data() + location.offset, data.data.data(), location.size) == 0;
+}
+}
+
+bool TextureDedupPool::Register(const TextureDedupContent& content, const fs::path& pngPath)
+{
+	std::string key = StringHelper::Sprintf("%s %08X %08X", content.settings.c_str(),
+	                                        GetDataCrc(content.texture), GetDataCrc(content.tlut));
+
+	{
+		std::lock_guard<std::mutex> lock(sPoolMutex);
+		std::vector<PoolEntry>& entries = sPool[key];
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const PoolEntry& entry) {
+			return HasSameData(entry.texture, content.texture) &&
+			       HasSameData(entry.tlut, content.tlut);
+		});
+
+		if (it == entries.end())
+		{
+			PoolEntry& entry = entries.emplace_back();
+
+			entry.texture = GetDataLocation(content.texture);
+			entry.tlut = GetDataLocation(content.tlut);
+			entry.writtenPath = pngPath;
+			it = std::prev(entries.end());
+		}
+
+		it->paths.insert(pngPath);
+		if (it->writtenPath == pngPath)
+			return true;
+	}
+
+	// Don't leave the PNG of a previous extraction behind, the build would convert it again
+	std::error_code error;
+	fs::remove(pngPath, error);
+
+	return false;
+}
+
+void TextureDedupPool::WriteManifest(const fs::path& manifestPath)
+{
+	std::lock_guard<std::mutex> lock(sPoolMutex);
+	std::vector<std::string> lines;
+
+	for (const auto& [key, entries] : sPool)
+	{
+		for (const PoolEntry& entry : entries)
+		{
+			fs::path canonicalPath = *entry.paths.begin();
+
+			if (entry.writtenPath != canonicalPath)
+			{
+				std::error_code error;
+				fs::rename(entry.writtenPath, canonicalPath, error);
+
+				// Keep the PNG where it is, the duplicates are built from it all the same
+				if (error)
+				{
+					HANDLE_WARNING(WarningType::Always,
+					               StringHelper::Sprintf("couldn't move '%s' to '%s'",
+					                                     entry.writtenPath.c_str(),
+					                                     canonicalPath.c_str()),
+					               error.message());
+					canonicalPath = entry.writtenPath;
+				}
+			}
+
+			for (const fs::path& path : entry.paths)
+			{
+				if (path != canonicalPath)
+					lines.push_back(path.generic_string() + "\t" + canonicalPath.generic_string() +
+					                "\n");
+			}
+		}
+	}
+
+	std::sort(lines.begin(), lines.end());
+
+	std::string manifest;
+	for (const std::string& line : lines)
+		manifest += line;
+
+	File::WriteAllTextIfChanged(manifestPath, manifest);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Utils/ByteSpan.h"
+#include "Utils/Directory.h"
+
+/**
+ * Bytes of a texture or TLUT, along with the binary file they were read from, so they can be
+ * compared again once that file has been unloaded.
+ */
+struct TextureDedupData
+{
+	fs::path filePath;
+	uint32_t offset = 0;
+	ByteSpan data;
+};
+
+/**
+ * Everything the PNG of a texture depends on.
+ */
+struct TextureDedupContent
+{
+	std::string settings;  // Format and size of the texture, and of its TLUT if any
+	TextureDedupData texture;
+	TextureDedupData tlut;  // Empty if the texture has no TLUT
+};
+
+/**
+ * Pool of the textures extracted by a run, enabled with `--dedup-textures`.
+ *
+ * Textures are identified by their content (format, size, raw data and TLUT), so a texture found
+ * in several files or several times in the same file is only written once. The pool only keeps a
+ * CRC32 of the data, and maps the file of a texture again to compare it with one of the same CRC.
+ * Once every file has been extracted, the PNG of each unique texture is moved to the first of its
+ * paths (in lexicographic order, so the output doesn't depend on the order the jobs ran in) and
+ * the manifest lists every PNG that wasn't written next to the PNG it is a duplicate of.
+ */
+class TextureDedupPool
+{
+public:
+	// Returns true if the PNG should be written to `pngPath`, false if it is a duplicate.
+	static bool Register(const TextureDedupContent& content, const fs::path& pngPath);
+
+	// Writes a `<duplicate png>\t<canonical png>` line per duplicate.
+	static void WriteManifest(const fs::path& manifestPath);
+};
@@ -138,7 +138,7 @@ size_t ZActorList::GetActorListArraySize() const
 
 /* ActorSpawnEntry */
 
-ActorSpawnEntry::ActorSpawnEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+ActorSpawnEntry::ActorSpawnEntry(ByteSpan rawData, uint32_t rawDataIndex)
 {
 	actorNum = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
 	posX = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
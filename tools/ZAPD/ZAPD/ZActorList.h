@@ -15,7 +15,7 @@ public:
 	uint16_t params;
 	size_t largestActorName = 16;
 
-	ActorSpawnEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	ActorSpawnEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 
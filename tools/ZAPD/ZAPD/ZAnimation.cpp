@@ -5,6 +5,7 @@
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/File.h"
+#include "Utils/SpanReader.h"
 #include "Utils/StringHelper.h"
 #include "WarningHandler.h"
 #include "ZFile.h"
@@ -51,7 +52,7 @@ void ZNormalAnimation::ParseRawData()
 {
 	ZAnimation::ParseRawData();
 
-	auto& data = parent->GetRawData();
+	const auto& data = parent->GetRawData();
 
 	rotationValuesSeg = BitConverter::ToInt32BE(data, rawDataIndex + 4);
 	rotationIndicesSeg = BitConverter::ToInt32BE(data, rawDataIndex + 8);
@@ -60,24 +61,20 @@ void ZNormalAnimation::ParseRawData()
 	rotationValuesOffset = Seg2Filespace(rotationValuesSeg, parent->baseAddress);
 	rotationIndicesOffset = Seg2Filespace(rotationIndicesSeg, parent->baseAddress);
 
-	uint32_t currentPtr = rotationValuesOffset;
+	SpanReader reader(data, rotationValuesOffset);
 
 	// Read the Rotation Values
-	for (uint32_t i = 0; i < ((rotationIndicesOffset - rotationValuesOffset) / 2); i++)
-	{
-		rotationValues.push_back(BitConverter::ToInt16BE(data, currentPtr));
-		currentPtr += 2;
-	}
-
-	currentPtr = rotationIndicesOffset;
+	reader.ReadArrayBE(rotationValues, (rotationIndicesOffset - rotationValuesOffset) / 2);
 
 	// Read the Rotation Indices
+	reader.Seek(rotationIndicesOffset);
 	for (uint32_t i = 0; i < ((rawDataIndex - rotationIndicesOffset) / 6); i++)
 	{
-		rotationIndices.push_back(RotationIndex(BitConverter::ToInt16BE(data, currentPtr),
-		                                        BitConverter::ToInt16BE(data, currentPtr + 2),
-		                                        BitConverter::ToInt16BE(data, currentPtr + 4)));
-		currentPtr += 6;
+		uint16_t x = reader.ReadUInt16BE();
+		uint16_t y = reader.ReadUInt16BE();
+		uint16_t z = reader.ReadUInt16BE();
+
+		rotationIndices.push_back(RotationIndex(x, y, z));
 	}
 }
 
@@ -174,7 +171,7 @@ std::string ZLinkAnimation::GetBodySourceCode() const
 
 /* ZCurveAnimation */
 
-TransformData::TransformData(ZFile* parent, const std::vector<uint8_t>& rawData,
+TransformData::TransformData(ZFile* parent, ByteSpan rawData,
                              uint32_t fileOffset)
 	: parent(parent)
 {
@@ -185,7 +182,7 @@ TransformData::TransformData(ZFile* parent, const std::vector<uint8_t>& rawData,
 	unk_08 = BitConverter::ToFloatBE(rawData, fileOffset + 8);
 }
 
-TransformData::TransformData(ZFile* parent, const std::vector<uint8_t>& rawData,
+TransformData::TransformData(ZFile* parent, ByteSpan rawData,
                              uint32_t fileOffset, size_t index)
 	: TransformData(parent, rawData, fileOffset + index * GetRawDataSize())
 {
@@ -413,14 +410,10 @@ void ZLegacyAnimation::ParseRawData()
 		uint32_t frameDataOffset = Seg2Filespace(frameData, parent->baseAddress);
 		uint32_t jointKeyOffset = Seg2Filespace(jointKey, parent->baseAddress);
 
-		uint32_t ptr = frameDataOffset;
-		for (size_t i = 0; i < (jointKeyOffset - frameDataOffset) / 2; i++)
-		{
-			frameDataArray.push_back(BitConverter::ToUInt16BE(rawData, ptr));
-			ptr += 2;
-		}
+		SpanReader reader(rawData, frameDataOffset);
+		reader.ReadArrayBE(frameDataArray, (jointKeyOffset - frameDataOffset) / 2);
 
-		ptr = jointKeyOffset;
+		uint32_t ptr = jointKeyOffset;
 		for (int32_t i = 0; i < limbCount + 1; i++)
 		{
 			JointKey key(parent);
@@ -85,8 +85,8 @@ protected:
 
 public:
 	TransformData() = default;
-	TransformData(ZFile* parent, const std::vector<uint8_t>& rawData, uint32_t fileOffset);
-	TransformData(ZFile* parent, const std::vector<uint8_t>& rawData, uint32_t fileOffset,
+	TransformData(ZFile* parent, ByteSpan rawData, uint32_t fileOffset);
+	TransformData(ZFile* parent, ByteSpan rawData, uint32_t fileOffset,
 	              size_t index);
 
 	[[nodiscard]] std::string GetBody(const std::string& prefix) const;
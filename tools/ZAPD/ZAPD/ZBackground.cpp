@@ -156,7 +156,8 @@ std::string ZBackground::GetExternalExtension() const
 void ZBackground::Save(const fs::path& outFolder)
 {
 	fs::path filepath = outFolder / (outName + "." + GetExternalExtension());
-	File::WriteAllBytes(filepath.string(), data);
+	File::WriteAllBytesIfChanged(filepath, data);
+	Globals::Instance->outputFiles.push_back(filepath);
 }
 
 std::string ZBackground::GetBodySourceCode() const
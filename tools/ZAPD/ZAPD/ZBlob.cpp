@@ -64,12 +64,14 @@ std::string ZBlob::GetBodySourceCode() const
 {
 	std::string sourceOutput;
 
+	sourceOutput.reserve(blobData.size() * 6 + blobData.size() / 16 * 2 + 2);
+
 	for (size_t i = 0; i < blobData.size(); i += 1)
 	{
 		if (i % 16 == 0)
 			sourceOutput += "\t";
 
-		sourceOutput += StringHelper::Sprintf("0x%02X, ", blobData[i]);
+		StringHelper::AppendFormat(sourceOutput, "0x%02X, ", blobData[i]);
 
 		if (i % 16 == 15)
 			sourceOutput += "\n";
@@ -85,7 +87,8 @@ std::string ZBlob::GetBodySourceCode() const
 
 void ZBlob::Save(const fs::path& outFolder)
 {
-	File::WriteAllBytes((outFolder / (name + ".bin")).string(), blobData);
+	File::WriteAllBytesIfChanged(outFolder / (name + ".bin"), blobData);
+	Globals::Instance->outputFiles.push_back(outFolder / (name + ".bin"));
 }
 
 bool ZBlob::IsExternalResource() const
@@ -8,6 +8,7 @@
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
+#include "WarningHandler.h"
 
 REGISTER_ZFILENODE(Collision, ZCollisionHeader);
 
@@ -49,46 +50,40 @@ void ZCollisionHeader::ParseRawData()
 	camDataSegmentOffset = Seg2Filespace(camDataAddress, parent->baseAddress);
 	waterBoxSegmentOffset = Seg2Filespace(waterBoxAddress, parent->baseAddress);
 
-	vertices.reserve(numVerts);
-	polygons.reserve(numPolygons);
+	vertices.resize(numVerts);
+	polygons.resize(numPolygons);
 	waterBoxes.reserve(numWaterBoxes);
 
-	offset_t currentPtr = vtxSegmentOffset;
-
-	for (uint16_t i = 0; i < numVerts; i++)
-	{
-		ZVector vec(parent);
-		vec.ExtractFromBinary(currentPtr, ZScalarType::ZSCALAR_S16, 3);
-
-		currentPtr += vec.GetRawDataSize();
-		vertices.push_back(vec);
-	}
-
-	for (uint16_t i = 0; i < numPolygons; i++)
+	const uint8_t* vtxData = GetArrayData(vtxSegmentOffset, numVerts * 6, "vertex");
+	for (CollisionVertex& vtx : vertices)
 	{
-		ZCollisionPoly poly(parent);
-		poly.SetRawDataIndex(polySegmentOffset + (i * 16));
-		poly.ParseRawData();
-		polygons.push_back(poly);
+		vtx.x = BitConverter::ToInt16BE(vtxData + 0);
+		vtx.y = BitConverter::ToInt16BE(vtxData + 2);
+		vtx.z = BitConverter::ToInt16BE(vtxData + 4);
+		vtxData += 6;
 	}
 
 	uint16_t highestPolyType = 0;
 
-	for (const ZCollisionPoly& poly : polygons)
+	const uint8_t* polyData = GetArrayData(polySegmentOffset, numPolygons * 16, "polygon");
+	for (CollisionPolyData& poly : polygons)
 	{
+		poly.Decode(polyData);
+		polyData += 16;
+
 		if (poly.type > highestPolyType)
 			highestPolyType = poly.type;
 	}
 
-	for (uint16_t i = 0; i < highestPolyType + 1; i++)
+	polygonTypes.resize(highestPolyType + 1);
+
+	const uint8_t* polyTypeData =
+		GetArrayData(polyTypeDefSegmentOffset, polygonTypes.size() * 8, "surface type");
+	for (SurfaceTypeData& polyType : polygonTypes)
 	{
-		ZSurfaceType surfaceType(parent);
-		surfaceType.SetRawDataIndex(polyTypeDefSegmentOffset + (i * 8));
-		surfaceType.ParseRawData();
-		polygonTypes.push_back(surfaceType);
+		polyType.Decode(polyTypeData);
+		polyTypeData += 8;
 	}
-	// polygonTypes.push_back(
-	//	BitConverter::ToUInt64BE(rawData, polyTypeDefSegmentOffset + (i * 8)));
 
 	if (camDataAddress != SEGMENTED_NULL)
 	{
@@ -187,7 +182,7 @@ void ZCollisionHeader::DeclareReferences(const std::string& prefix)
 		}
 
 		parent->AddDeclarationArray(polySegmentOffset, DeclarationAlignment::Align4,
-		                            polygons.size() * 16, polygons[0].GetSourceTypeName().c_str(),
+		                            polygons.size() * 16, "CollisionPoly",
 		                            StringHelper::Sprintf("%sPolygons", auxName.c_str()),
 		                            polygons.size(), declaration);
 	}
@@ -200,8 +195,7 @@ void ZCollisionHeader::DeclareReferences(const std::string& prefix)
 
 	if (polyTypeDefAddress != SEGMENTED_NULL)
 		parent->AddDeclarationArray(polyTypeDefSegmentOffset, DeclarationAlignment::Align4,
-		                            polygonTypes.size() * 8,
-		                            polygonTypes[0].GetSourceTypeName().c_str(),
+		                            polygonTypes.size() * 8, "SurfaceType",
 		                            StringHelper::Sprintf("%sSurfaceType", auxName.c_str()),
 		                            polygonTypes.size(), declaration);
 
@@ -213,19 +207,20 @@ void ZCollisionHeader::DeclareReferences(const std::string& prefix)
 
 		for (size_t i = 0; i < vertices.size(); i++)
 		{
+			const CollisionVertex& vtx = vertices[i];
+
 			declaration +=
-				StringHelper::Sprintf("\t{ %s },", vertices[i].GetBodySourceCode().c_str());
+				StringHelper::Sprintf("\t{ %6hd, %6hd, %6hd },", vtx.x, vtx.y, vtx.z);
 
 			if (i < vertices.size() - 1)
 				declaration += "\n";
 		}
 
-		const auto& first = vertices.front();
 		if (vtxAddress != 0)
-			parent->AddDeclarationArray(
-				vtxSegmentOffset, first.GetDeclarationAlignment(),
-				vertices.size() * first.GetRawDataSize(), first.GetSourceTypeName(),
-				StringHelper::Sprintf("%sVertices", auxName.c_str()), vertices.size(), declaration);
+			parent->AddDeclarationArray(vtxSegmentOffset, DeclarationAlignment::Align4,
+			                            vertices.size() * 6, "Vec3s",
+			                            StringHelper::Sprintf("%sVertices", auxName.c_str()),
+			                            vertices.size(), declaration);
 	}
 }
 
@@ -296,8 +291,31 @@ size_t ZCollisionHeader::GetRawDataSize() const
 	return 44;
 }
 
+/**
+ * Returns the raw data of the `size` bytes long array at `offset`, after checking that the whole
+ * array is in the file so its elements can be decoded without checking each read.
+ */
+const uint8_t* ZCollisionHeader::GetArrayData(offset_t offset, size_t size, const char* arrayName)
+{
+	const auto& rawData = parent->GetRawData();
+
+	if (size == 0)
+		return nullptr;
+
+	if (offset + size > rawData.size())
+	{
+		std::string errorHeader =
+			StringHelper::Sprintf("%s array extends past the end of the file (0x%zX bytes)",
+		                          arrayName, rawData.size());
+		HANDLE_ERROR_RESOURCE(WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+		                      errorHeader, "");
+	}
+
+	return rawData.data() + offset;
+}
+
 CameraDataList::CameraDataList(ZFile* parent, const std::string& prefix,
-                               const std::vector<uint8_t>& rawData, offset_t rawDataIndex,
+                               ByteSpan rawData, offset_t rawDataIndex,
                                offset_t upperCameraBoundary)
 {
 	std::string declaration;
@@ -405,7 +423,7 @@ CameraDataList::~CameraDataList()
 {
 }
 
-CameraPositionData::CameraPositionData(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+CameraPositionData::CameraPositionData(ByteSpan rawData, uint32_t rawDataIndex)
 {
 	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 0);
 	y = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
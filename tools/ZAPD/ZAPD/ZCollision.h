@@ -5,7 +5,6 @@
 #include "ZResource.h"
 #include "ZRoom/ZRoom.h"
 #include "ZSurfaceType.h"
-#include "ZVector.h"
 #include "ZWaterbox.h"
 
 class CameraPositionData
@@ -13,7 +12,13 @@ class CameraPositionData
 public:
 	int16_t x, y, z;
 
-	CameraPositionData(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CameraPositionData(ByteSpan rawData, uint32_t rawDataIndex);
+};
+
+class CollisionVertex
+{
+public:
+	int16_t x, y, z;
 };
 
 class CameraDataEntry
@@ -30,7 +35,7 @@ public:
 	std::vector<CameraDataEntry> entries;
 	std::vector<CameraPositionData> cameraPositionData;
 
-	CameraDataList(ZFile* parent, const std::string& prefix, const std::vector<uint8_t>& rawData,
+	CameraDataList(ZFile* parent, const std::string& prefix, ByteSpan rawData,
 	               offset_t rawDataIndex, offset_t upperCameraBoundary);
 	~CameraDataList();
 };
@@ -53,9 +58,11 @@ public:
 	uint32_t vtxSegmentOffset, polySegmentOffset, polyTypeDefSegmentOffset, camDataSegmentOffset,
 		waterBoxSegmentOffset;
 
-	std::vector<ZVector> vertices;
-	std::vector<ZCollisionPoly> polygons;
-	std::vector<ZSurfaceType> polygonTypes;
+	// Kept as plain data rather than as ZCollisionPoly and ZSurfaceType resources, since a scene
+	// mesh can have thousands of vertices and polygons.
+	std::vector<CollisionVertex> vertices;
+	std::vector<CollisionPolyData> polygons;
+	std::vector<SurfaceTypeData> polygonTypes;
 	std::vector<ZWaterbox> waterBoxes;
 	CameraDataList* camData = nullptr;
 
@@ -72,4 +79,7 @@ public:
 	ZResourceType GetResourceType() const override;
 
 	size_t GetRawDataSize() const override;
+
+protected:
+	const uint8_t* GetArrayData(offset_t offset, size_t size, const char* arrayName);
 };
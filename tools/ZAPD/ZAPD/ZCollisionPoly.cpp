@@ -3,9 +3,32 @@
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
+#include "WarningHandler.h"
 
 REGISTER_ZFILENODE(CollisionPoly, ZCollisionPoly);
 
+void CollisionPolyData::Decode(const uint8_t* data)
+{
+	type = BitConverter::ToUInt16BE(data + 0);
+
+	vtxA = BitConverter::ToUInt16BE(data + 2);
+	vtxB = BitConverter::ToUInt16BE(data + 4);
+	vtxC = BitConverter::ToUInt16BE(data + 6);
+
+	normX = BitConverter::ToUInt16BE(data + 8);
+	normY = BitConverter::ToUInt16BE(data + 10);
+	normZ = BitConverter::ToUInt16BE(data + 12);
+
+	dist = BitConverter::ToUInt16BE(data + 14);
+}
+
+std::string CollisionPolyData::GetBodySourceCode() const
+{
+	return StringHelper::Sprintf(
+		"{0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X}", type, vtxA, vtxB, vtxC,
+		normX, normY, normZ, dist);
+}
+
 ZCollisionPoly::ZCollisionPoly(ZFile* nParent) : ZResource(nParent)
 {
 }
@@ -17,17 +40,12 @@ ZCollisionPoly::~ZCollisionPoly()
 void ZCollisionPoly::ParseRawData()
 {
 	const auto& rawData = parent->GetRawData();
-	type = BitConverter::ToUInt16BE(rawData, rawDataIndex + 0);
 
-	vtxA = BitConverter::ToUInt16BE(rawData, rawDataIndex + 2);
-	vtxB = BitConverter::ToUInt16BE(rawData, rawDataIndex + 4);
-	vtxC = BitConverter::ToUInt16BE(rawData, rawDataIndex + 6);
+	if (rawDataIndex + GetRawDataSize() > rawData.size())
+		HANDLE_ERROR_RESOURCE(WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+		                      "CollisionPoly extends past the end of the file", "");
 
-	normX = BitConverter::ToUInt16BE(rawData, rawDataIndex + 8);
-	normY = BitConverter::ToUInt16BE(rawData, rawDataIndex + 10);
-	normZ = BitConverter::ToUInt16BE(rawData, rawDataIndex + 12);
-
-	dist = BitConverter::ToUInt16BE(rawData, rawDataIndex + 14);
+	poly.Decode(rawData.data() + rawDataIndex);
 }
 
 void ZCollisionPoly::DeclareReferences(const std::string& prefix)
@@ -44,12 +62,7 @@ void ZCollisionPoly::DeclareReferences(const std::string& prefix)
 
 std::string ZCollisionPoly::GetBodySourceCode() const
 {
-	std::string declaration;
-
-	declaration +=
-		StringHelper::Sprintf("{0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X, 0x%04X}",
-	                          type, vtxA, vtxB, vtxC, normX, normY, normZ, dist);
-	return declaration;
+	return poly.GetBodySourceCode();
 }
 
 std::string ZCollisionPoly::GetDefaultName(const std::string& prefix) const
@@ -3,7 +3,10 @@
 #include "ZFile.h"
 #include "ZResource.h"
 
-class ZCollisionPoly : public ZResource
+/**
+ * The fields of a CollisionPoly.
+ */
+class CollisionPolyData
 {
 public:
 	uint16_t type;
@@ -11,6 +14,16 @@ public:
 	uint16_t normX, normY, normZ;
 	uint16_t dist;
 
+	// Decodes the 16 big-endian bytes at `data`.
+	void Decode(const uint8_t* data);
+	std::string GetBodySourceCode() const;
+};
+
+class ZCollisionPoly : public ZResource
+{
+public:
+	CollisionPolyData poly;
+
 	ZCollisionPoly(ZFile* nParent);
 	~ZCollisionPoly();
 
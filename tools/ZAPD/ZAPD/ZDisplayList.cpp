@@ -8,6 +8,7 @@
 
 #include "Globals.h"
 #include "OutputFormatter.h"
+#include "Profiler.h"
 #include "Utils/BitConverter.h"
 #include "Utils/File.h"
 #include "Utils/Path.h"
@@ -65,8 +66,7 @@ void ZDisplayList::ExtractWithXML(tinyxml2::XMLElement* reader, uint32_t nRawDat
 	// Don't parse raw data of external files
 	if (parent->GetMode() != ZFileMode::ExternalFile)
 	{
-		int32_t rawDataSize =
-			ZDisplayList::GetDListLength(parent->GetRawData(), rawDataIndex, dListType);
+		int32_t rawDataSize = ZDisplayList::GetDListLength(parent, rawDataIndex, dListType);
 		numInstructions = rawDataSize / 8;
 		ParseRawData();
 	}
@@ -100,6 +100,8 @@ void ZDisplayList::ParseRawData()
 		instructions.push_back(BitConverter::ToUInt64BE(rawData, ptr));
 		ptr += 8;
 	}
+
+	parent->AddDListResource(rawDataIndex, this);
 }
 
 Declaration* ZDisplayList::DeclareVar([[maybe_unused]] const std::string& prefix,
@@ -291,11 +293,7 @@ void ZDisplayList::ParseF3DZEX(F3DZEXOpcode opcode, uint64_t data, int32_t i,
 			sprintf(line, "gsSPBranchLessZraw(%sDlist0x%06X, 0x%02X, 0x%02X),", prefix.c_str(),
 			        h & 0x00FFFFFF, (a / 5) | (b / 2), z);
 
-			ZDisplayList* nList = new ZDisplayList(parent);
-			nList->ExtractFromBinary(
-				h & 0x00FFFFFF, GetDListLength(parent->GetRawData(), h & 0x00FFFFFF, dListType));
-			nList->SetName(nList->GetDefaultName(prefix));
-			otherDLists.push_back(nList);
+			ParseCalledDList(h & 0x00FFFFFF, prefix);
 
 			i++;
 		}
@@ -441,9 +439,18 @@ void ZDisplayList::ParseF3DEX(F3DEXOpcode opcode, uint64_t data, const std::stri
 	}
 }
 
-int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex,
-                                     DListType dListType)
+int32_t ZDisplayList::GetDListLength(ZFile* file, uint32_t rawDataIndex, DListType dListType)
 {
+	ZDisplayList* dList = file->GetDListResource(rawDataIndex);
+
+	if (dList != nullptr && dList->dListType == dListType)
+	{
+		Profiler::IncrementCounter(ProfileCounter::DListCacheHits);
+		return dList->numInstructions * 8;
+	}
+
+	Profiler::IncrementCounter(ProfileCounter::DListCacheMisses);
+
 	uint8_t endDLOpcode;
 	uint8_t branchListOpcode;
 
@@ -458,11 +465,13 @@ int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32
 		branchListOpcode = static_cast<uint8_t>(F3DEXOpcode::G_DL);
 	}
 
-	uint32_t ptr = rawDataIndex;
+	ByteSpan rawData = file->GetRawData();
 	size_t rawDataSize = rawData.size();
+	uint32_t ptr = rawDataIndex;
+
 	while (true)
 	{
-		if (ptr >= rawDataSize)
+		if (ptr + 1 >= rawDataSize)
 		{
 			std::string errorHeader =
 				StringHelper::Sprintf("reached end of file when trying to find the end of the "
@@ -472,8 +481,8 @@ int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32
 			HANDLE_ERROR_PROCESS(WarningType::Always, errorHeader, errorBody);
 		}
 
-		uint8_t opcode = rawData.at(ptr);
-		bool dlNoPush = rawData.at(ptr + 1) == 1;
+		uint8_t opcode = rawData[ptr];
+		bool dlNoPush = rawData[ptr + 1] == 1;
 		ptr += 8;
 
 		if (opcode == endDLOpcode || (opcode == branchListOpcode && dlNoPush))
@@ -483,6 +492,27 @@ int32_t ZDisplayList::GetDListLength(const std::vector<uint8_t>& rawData, uint32
 	}
 }
 
+std::string ZDisplayList::ParseCalledDList(uint32_t dListOffset, const std::string& prefix)
+{
+	ZDisplayList* dList = parent->GetDListResource(dListOffset);
+
+	if (dList != nullptr && dList->dListType == dListType)
+	{
+		// Shared by several lists, or also declared by another resource
+		Profiler::IncrementCounter(ProfileCounter::DListCacheHits);
+	}
+	else
+	{
+		dList = new ZDisplayList(parent);
+		dList->dListType = dListType;
+		dList->ExtractFromBinary(dListOffset, GetDListLength(parent, dListOffset, dListType));
+		dList->SetName(dList->GetDefaultName(prefix));
+		otherDLists.push_back(dList);
+	}
+
+	return dList->GetDefaultName(prefix);
+}
+
 bool ZDisplayList::SequenceCheck(std::vector<F3DZEXOpcode> sequence, int32_t startIndex)
 {
 	bool success = true;
@@ -735,12 +765,7 @@ void ZDisplayList::Opcode_G_DL(uint64_t data, const std::string& prefix, char* l
 	}
 	else
 	{
-		ZDisplayList* nList = new ZDisplayList(parent);
-		nList->ExtractFromBinary(GETSEGOFFSET(data), GetDListLength(parent->GetRawData(),
-		                                                            GETSEGOFFSET(data), dListType));
-		nList->SetName(nList->GetDefaultName(prefix));
-
-		otherDLists.push_back(nList);
+		ParseCalledDList(GETSEGOFFSET(data), prefix);
 	}
 }
 
@@ -806,7 +831,7 @@ void ZDisplayList::Opcode_G_MTX(uint64_t data, char* line)
 	std::string matrixRef;
 
 	if (Globals::Instance->cfg.symbolMap.find(mm) != Globals::Instance->cfg.symbolMap.end())
-		matrixRef = StringHelper::Sprintf("&%s", Globals::Instance->cfg.symbolMap[mm].c_str());
+		matrixRef = StringHelper::Sprintf("&%s", Globals::Instance->cfg.symbolMap.at(mm).c_str());
 	else
 		matrixRef = StringHelper::Sprintf("0x%08X", mm);
 
@@ -884,21 +909,7 @@ void ZDisplayList::Opcode_G_VTX(uint64_t data, char* line)
 		}
 
 		if (nn > 0)
-		{
-			std::vector<ZVtx> vtxList;
-			vtxList.reserve(nn);
-
-			for (int32_t i = 0; i < nn; i++)
-			{
-				ZVtx vtx(parent);
-				vtx.ExtractFromFile(currentPtr);
-				vtxList.push_back(vtx);
-
-				currentPtr += 16;
-			}
-
-			vertices[vtxAddr] = vtxList;
-		}
+			vertices[currentPtr] = nn;
 	}
 }
 
@@ -1630,26 +1641,10 @@ static int32_t GfxdCallback_Vtx(uint32_t seg, int32_t count)
 
 		if (count > 0)
 		{
-			std::vector<ZVtx> vtxList;
-			vtxList.reserve(count);
-
-			uint32_t currentPtr = vtxOffset;
-			for (int32_t i = 0; i < count; i++)
-			{
-				ZVtx vtx(self->parent);
-				vtx.ExtractFromFile(currentPtr);
-
-				vtxList.push_back(vtx);
-				currentPtr += 16;
-			}
-
-			bool keyAlreadyOccupied = self->vertices.find(vtxOffset) != self->vertices.end();
-
 			// In some cases a vtxList already exists at vtxOffset. Only override the existing list
 			// if the new one is bigger.
-			if (!keyAlreadyOccupied ||
-			    (keyAlreadyOccupied && vtxList.size() > self->vertices[vtxOffset].size()))
-				self->vertices[vtxOffset] = vtxList;
+			uint32_t& vtxCount = self->vertices[vtxOffset];
+			vtxCount = std::max<uint32_t>(vtxCount, count);
 		}
 	}
 
@@ -1722,13 +1717,7 @@ static int32_t GfxdCallback_DisplayList(uint32_t seg)
 	{
 		if (self->parent->segment == dListSegNum)
 		{
-			ZDisplayList* newDList = new ZDisplayList(self->parent);
-			newDList->ExtractFromBinary(
-				dListOffset,
-				self->GetDListLength(self->parent->GetRawData(), dListOffset, self->dListType));
-			newDList->SetName(newDList->GetDefaultName(self->parent->GetName()));
-			self->otherDLists.push_back(newDList);
-			dListName = newDList->GetName();
+			dListName = self->ParseCalledDList(dListOffset, self->parent->GetName());
 		}
 		else
 		{
@@ -1790,121 +1779,49 @@ void ZDisplayList::DeclareReferences(const std::string& prefix)
 		sourceOutput += ProcessGfxDis(prefix);
 
 	// Iterate through our vertex lists, connect intersecting lists.
-	if (vertices.size() > 0)
-	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> verticesSorted(vertices.begin(),
-		                                                                   vertices.end());
-
-		for (size_t i = 0; i < verticesSorted.size() - 1; i++)
-		{
-			size_t vtxSize = vertices[verticesSorted[i].first].size() * 16;
-
-			if ((verticesSorted[i].first + vtxSize) > verticesSorted[i + 1].first)
-			{
-				int32_t intersectAmt =
-					(verticesSorted[i].first + vtxSize) - verticesSorted[i + 1].first;
-				int32_t intersectIndex = intersectAmt / 16;
-
-				for (size_t j = intersectIndex; j < verticesSorted[i + 1].second.size(); j++)
-					vertices[verticesSorted[i].first].push_back(verticesSorted[i + 1].second[j]);
-
-				vertices.erase(verticesSorted[i + 1].first);
-				verticesSorted.erase(verticesSorted.begin() + i + 1);
-
-				i--;
-			}
-		}
-
-		// Generate Vertex Declarations
-		for (auto& item : vertices)
-		{
-			std::string declaration = "";
+	MergeConnectingVertexLists(!Globals::Instance->useLegacyZDList);
 
-			offset_t curAddr = item.first;
-			auto& firstVtx = item.second.at(0);
-
-			for (auto vtx : item.second)
-				declaration += StringHelper::Sprintf("\t%s,\n", vtx.GetBodySourceCode().c_str());
-
-			Declaration* decl = parent->AddDeclarationArray(
-				curAddr, firstVtx.GetDeclarationAlignment(),
-				item.second.size() * firstVtx.GetRawDataSize(), firstVtx.GetSourceTypeName(),
-				firstVtx.GetDefaultName(name), item.second.size(), declaration);
-			decl->isExternal = true;
-		}
-	}
-
-	Declaration* decl = DeclareVar("", sourceOutput);
-	decl->references = references;
+	// Generate Vertex Declarations, straight from the raw data of the file
+	const auto& rawData = parent->GetRawData();
 
-	// Iterate through our vertex lists, connect intersecting lists.
-	if (vertices.size() > 0)
+	for (const auto& [vtxOffset, vtxCount] : vertices)
 	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> verticesSorted(vertices.begin(),
-		                                                                   vertices.end());
-
-		for (size_t i = 0; i < verticesSorted.size() - 1; i++)
+		if (vtxOffset + vtxCount * 16 > rawData.size())
 		{
-			// int32_t vtxSize = verticesSorted[i].second.size() * 16;
-			size_t vtxSize = vertices[verticesSorted[i].first].size() * 16;
-
-			if ((verticesSorted[i].first + vtxSize) > verticesSorted[i + 1].first)
-			{
-				int32_t intersectAmt =
-					(verticesSorted[i].first + vtxSize) - verticesSorted[i + 1].first;
-				int32_t intersectIndex = intersectAmt / 16;
-
-				for (size_t j = intersectIndex; j < verticesSorted[i + 1].second.size(); j++)
-					vertices[verticesSorted[i].first].push_back(verticesSorted[i + 1].second[j]);
-
-				vertices.erase(verticesSorted[i + 1].first);
-				verticesSorted.erase(verticesSorted.begin() + i + 1);
-
-				i--;
-			}
+			std::string errorHeader = StringHelper::Sprintf(
+				"vertex array at 0x%06X extends past the end of the file (0x%zX bytes)", vtxOffset,
+				rawData.size());
+			HANDLE_ERROR_RESOURCE(WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+			                      errorHeader, "");
 		}
 
-		// Generate Vertex Declarations
-		std::vector<int32_t> vtxKeys;
-		vtxKeys.reserve(vertices.size());
-		for (auto& item : vertices)
-			vtxKeys.push_back(item.first);
+		std::string vtxName;
+		ZResource* vtxRes = parent->FindResource(vtxOffset);
 
-		// for (pair<int32_t, vector<Vertex>> item : vertices)
-		for (size_t i = 0; i < vtxKeys.size(); i++)
-		{
-			auto& item = vertices[vtxKeys[i]];
-
-			std::string declaration;
-
-			for (auto& vtx : item)
-				declaration += StringHelper::Sprintf("\t%s,\n", vtx.GetBodySourceCode().c_str());
-
-			// Ensure there's always a trailing line feed to prevent dumb warnings.
-			// Please don't remove this line, unless you somehow made a way to prevent
-			// that warning when building the OoT repo.
-			declaration += "\n";
+		if (vtxRes != nullptr)
+			vtxName = vtxRes->GetName();
+		else
+			vtxName = StringHelper::Sprintf("%sVtx_%06X", prefix.c_str(), vtxOffset);
 
-			if (parent != nullptr)
-			{
-				std::string vtxName;
-				ZResource* vtxRes = parent->FindResource(vtxKeys[i]);
+		std::string declaration;
+		ZVtx::AppendArrayBodySourceCode(declaration, rawData.data() + vtxOffset, vtxCount);
 
-				if (vtxRes != nullptr)
-					vtxName = vtxRes->GetName();
-				else
-					vtxName = StringHelper::Sprintf("%sVtx_%06X", prefix.c_str(), vtxKeys[i]);
+		Declaration* vtxDecl =
+			parent->AddDeclarationArray(vtxOffset, DeclarationAlignment::Align8, vtxCount * 16,
+		                                "Vtx", vtxName, vtxCount, declaration);
+		if (vtxDecl == nullptr)
+			continue;
 
-				auto filepath = Globals::Instance->outputPath / vtxName;
-				std::string incStr =
-					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), "vtx");
+		auto filepath = Globals::Instance->outputPath / vtxName;
+		std::string incStr = StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), "vtx");
 
-				Declaration* vtxDecl = parent->AddDeclarationIncludeArray(
-					vtxKeys[i], incStr, item.size() * 16, "Vtx", vtxName, item.size());
-				vtxDecl->isExternal = true;
-			}
-		}
+		vtxDecl = parent->AddDeclarationIncludeArray(vtxOffset, incStr, vtxCount * 16, "Vtx",
+		                                             vtxName, vtxCount);
+		vtxDecl->isExternal = true;
 	}
+
+	Declaration* decl = DeclareVar("", sourceOutput);
+	decl->references = references;
 }
 
 std::string ZDisplayList::ProcessLegacy(const std::string& prefix)
@@ -1978,46 +1895,41 @@ std::string ZDisplayList::ProcessGfxDis([[maybe_unused]] const std::string& pref
 		gfxd_target(gfxd_f3dex);
 
 	gfxd_udata_set(this);
-	gfxd_execute();                               // generate display list
-	sourceOutput += outputformatter.GetOutput();  // write formatted display list
 
-	MergeConnectingVertexLists();
+	{
+		ProfileScope profileScope("Libgfxd", this);
+		gfxd_execute();  // generate display list
+	}
+
+	sourceOutput += outputformatter.GetOutput();  // write formatted display list
 
 	return sourceOutput;
 }
 
-void ZDisplayList::MergeConnectingVertexLists()
+void ZDisplayList::MergeConnectingVertexLists(bool mergeAdjacent)
 {
-	if (vertices.size() > 0)
-	{
-		std::vector<std::pair<uint32_t, std::vector<ZVtx>>> vertexKeys(vertices.begin(),
-		                                                               vertices.end());
-		std::pair<uint32_t, std::vector<ZVtx>> lastItem = vertexKeys.at(0);
-
-		for (size_t i = 1; i < vertexKeys.size(); i++)
-		{
-			std::pair<uint32_t, std::vector<ZVtx>> curItem = vertexKeys[i];
-
-			size_t lastItemEnd = lastItem.first + (lastItem.second.size() * 16);
-			bool lastItemIntersects = lastItemEnd >= curItem.first;
+	if (vertices.empty())
+		return;
 
-			if (lastItemIntersects)
-			{
-				int intersectedVtxStart = (lastItemEnd - curItem.first) / 16;
+	auto lastItem = vertices.begin();
 
-				for (size_t j = intersectedVtxStart; j < curItem.second.size(); j++)
-					vertices[lastItem.first].push_back(curItem.second[j]);
+	for (auto curItem = std::next(lastItem); curItem != vertices.end();)
+	{
+		size_t lastItemEnd = lastItem->first + (lastItem->second * 16);
+		bool lastItemIntersects = mergeAdjacent ? lastItemEnd >= curItem->first :
+		                                          lastItemEnd > curItem->first;
 
-				vertices.erase(curItem.first);
-				vertexKeys.erase(vertexKeys.begin() + i);
+		if (lastItemIntersects)
+		{
+			uint32_t intersectedVtxStart = (lastItemEnd - curItem->first) / 16;
 
-				lastItem.second = vertices[lastItem.first];
+			if (intersectedVtxStart < curItem->second)
+				lastItem->second += curItem->second - intersectedVtxStart;
 
-				i--;
-			}
-			else
-				lastItem = curItem;
+			curItem = vertices.erase(curItem);
 		}
+		else
+			lastItem = curItem++;
 	}
 }
 
@@ -2059,7 +1971,7 @@ bool ZDisplayList::TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t
 		{
 			// Try to find a non-external file (i.e., one we are actually extracting)
 			// which has the same segment number we are looking for.
-			for (auto& otherFile : Globals::Instance->cfg.segmentRefFiles[segmentNumber])
+			for (auto& otherFile : Globals::Instance->segmentRefFiles[segmentNumber])
 			{
 				if (!otherFile->isExternalFile)
 				{
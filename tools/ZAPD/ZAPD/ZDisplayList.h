@@ -334,7 +334,7 @@ public:
 
 	DListType dListType;
 
-	std::map<uint32_t, std::vector<ZVtx>> vertices;
+	std::map<uint32_t, uint32_t> vertices;  // Offset and vertex count of each vertex array used
 	std::vector<ZDisplayList*> otherDLists;
 
 	ZTexture* lastTexture = nullptr;
@@ -358,8 +358,12 @@ public:
 	static bool TextureGenCheck(int32_t texWidth, int32_t texHeight, uint32_t texAddr,
 	                            uint32_t texSeg, F3DZEXTexFormats texFmt, F3DZEXTexSizes texSiz,
 	                            bool texLoaded, bool texIsPalette, ZDisplayList* self);
-	static int32_t GetDListLength(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex,
-	                              DListType dListType);
+	// Size in bytes of the display list at `rawDataIndex`, up to its G_ENDDL or G_BRANCH_LIST. The
+	// size of a list of the same ucode already parsed at that offset is reused.
+	static int32_t GetDListLength(ZFile* file, uint32_t rawDataIndex, DListType dListType);
+	// Parses the display list at `dListOffset` called by this one, unless it was already parsed,
+	// and returns its default name.
+	std::string ParseCalledDList(uint32_t dListOffset, const std::string& prefix);
 
 	size_t GetRawDataSize() const override;
 	DeclarationAlignment GetDeclarationAlignment() const override;
@@ -367,8 +371,8 @@ public:
 	std::string ProcessLegacy(const std::string& prefix);
 	std::string ProcessGfxDis(const std::string& prefix);
 
-	// Combines vertex lists from the vertices map which touch or intersect
-	void MergeConnectingVertexLists();
+	// Combines vertex lists from the vertices map which intersect, or also touch if `mergeAdjacent`
+	void MergeConnectingVertexLists(bool mergeAdjacent);
 
 	bool IsExternalResource() const override;
 	std::string GetExternalExtension() const override;
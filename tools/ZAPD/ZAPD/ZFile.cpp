@@ -7,6 +7,7 @@
 
 #include "Globals.h"
 #include "OutputFormatter.h"
+#include "Profiler.h"
 #include "Utils/BinaryWriter.h"
 #include "Utils/BitConverter.h"
 #include "Utils/Directory.h"
@@ -86,6 +87,8 @@ ZFile::~ZFile()
 
 void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 {
+	ProfileScope profileScope("ParseXml");
+
 	assert(mode != ZFileMode::Invalid);
 
 	if (filename == "")
@@ -196,7 +199,13 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 			HANDLE_ERROR_PROCESS(WarningType::Always, errorHeader, "");
 		}
 
-		rawData = File::ReadAllBytes((basePath / name).string());
+		if (!rawDataFile.Open(basePath / name))
+		{
+			std::string errorHeader = StringHelper::Sprintf("couldn't map binary file '%s'.",
+			                                                (basePath / name).c_str());
+			HANDLE_ERROR_PROCESS(WarningType::Always, errorHeader, "");
+		}
+		rawData = rawDataFile.GetData();
 
 		if (reader->Attribute("RangeEnd") == nullptr)
 			rangeEnd = rawData.size();
@@ -272,7 +281,10 @@ void ZFile::ParseXML(tinyxml2::XMLElement* reader, const std::string& filename)
 			ZResource* nRes = nodeMap[nodeName](this);
 
 			if (mode == ZFileMode::Extract || mode == ZFileMode::ExternalFile)
+			{
+				ProfileScope resProfileScope("ParseRawData", nRes);
 				nRes->ExtractWithXML(child, rawDataIndex);
+			}
 
 			switch (nRes->GetResourceType())
 			{
@@ -309,6 +321,7 @@ void ZFile::DeclareResourceSubReferences()
 {
 	for (size_t i = 0; i < resources.size(); i++)
 	{
+		ProfileScope profileScope("DeclareReferences", resources.at(i));
 		resources.at(i)->DeclareReferences(name);
 	}
 }
@@ -344,7 +357,12 @@ const fs::path& ZFile::GetXmlFilePath() const
 	return xmlFilePath;
 }
 
-const std::vector<uint8_t>& ZFile::GetRawData() const
+fs::path ZFile::GetBinaryFilePath() const
+{
+	return basePath / name;
+}
+
+ByteSpan ZFile::GetRawData() const
 {
 	return rawData;
 }
@@ -361,9 +379,15 @@ void ZFile::ExtractResources()
 		Directory::CreateDirectory(GetSourceOutputFolderPath().string());
 
 	for (size_t i = 0; i < resources.size(); i++)
+	{
+		ProfileScope profileScope("ParseRawDataLate", resources[i]);
 		resources[i]->ParseRawDataLate();
+	}
 	for (size_t i = 0; i < resources.size(); i++)
+	{
+		ProfileScope profileScope("DeclareReferencesLate", resources[i]);
 		resources[i]->DeclareReferencesLate(name);
+	}
 
 	if (Globals::Instance->genSourceFile)
 		GenerateSourceFiles();
@@ -378,16 +402,22 @@ void ZFile::ExtractResources()
 
 	for (ZResource* res : resources)
 	{
-		auto memStreamRes = std::shared_ptr<MemoryStream>(new MemoryStream());
-		BinaryWriter writerRes = BinaryWriter(memStreamRes);
-
 		if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 			printf("Saving resource %s\n", res->GetName().c_str());
 
-		res->Save(outputPath);
+		{
+			ProfileScope profileScope("Save", res);
+			res->Save(outputPath);
+		}
 
 		// Check if we have an exporter "registered" for this resource type
 		ZResourceExporter* exporter = Globals::Instance->GetExporter(res->GetResourceType());
+		if (exporter == nullptr && (exporterSet == nullptr || exporterSet->resSaveFunc == nullptr))
+			continue;
+
+		auto memStreamRes = std::shared_ptr<MemoryStream>(new MemoryStream());
+		BinaryWriter writerRes = BinaryWriter(memStreamRes);
+
 		if (exporter != nullptr)
 		{
 			// exporter->Save(res, Globals::Instance->outputPath.string(), &writerFile);
@@ -400,10 +430,11 @@ void ZFile::ExtractResources()
 
 	if (memStreamFile->GetLength() > 0)
 	{
-		File::WriteAllBytes(StringHelper::Sprintf("%s%s.bin",
-		                                          Globals::Instance->outputPath.string().c_str(),
-		                                          GetName().c_str()),
-		                    memStreamFile->ToVector());
+		std::string binPath = StringHelper::Sprintf(
+			"%s%s.bin", Globals::Instance->outputPath.string().c_str(), GetName().c_str());
+
+		File::WriteAllBytes(binPath, memStreamFile->ToVector());
+		Globals::Instance->outputFiles.push_back(binPath);
 	}
 
 	writerFile.Close();
@@ -465,6 +496,7 @@ Declaration* ZFile::AddDeclaration(offset_t address, DeclarationAlignment alignm
 		decl->declBody = body;
 	}
 
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -498,6 +530,7 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 		decl->declBody = body;
 	}
 
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -528,6 +561,7 @@ Declaration* ZFile::AddDeclarationArray(offset_t address, DeclarationAlignment a
 		decl->arrayItemCntStr = arrayItemCntStr;
 		decl->declBody = body;
 	}
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -546,6 +580,7 @@ Declaration* ZFile::AddDeclarationPlaceholder(offset_t address, const std::strin
 	else
 		decl = declarations[address];
 
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -570,6 +605,7 @@ Declaration* ZFile::AddDeclarationInclude(offset_t address, const std::string& i
 		decl->declType = varType;
 		decl->declName = varName;
 	}
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -605,6 +641,7 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
 	}
+	IndexDeclaration(decl);
 	return decl;
 }
 
@@ -642,9 +679,24 @@ Declaration* ZFile::AddDeclarationIncludeArray(offset_t address, std::string& in
 		decl->isArray = true;
 		decl->arrayItemCnt = arrayItemCnt;
 	}
+	IndexDeclaration(decl);
 	return decl;
 }
 
+void ZFile::IndexDeclaration(Declaration* decl)
+{
+	maxDeclarationSize = std::max(maxDeclarationSize, decl->size);
+	Globals::Instance->AddSegmentedRef(GetSegmentedAddress(decl->address), decl->size, this);
+}
+
+segptr_t ZFile::GetSegmentedAddress(offset_t offset) const
+{
+	if (segment == 0x80)
+		return (segment << 24) | (GETSEGOFFSET(baseAddress) + offset);
+
+	return (segment << 24) | offset;
+}
+
 bool ZFile::DeclarationSanityChecks(uint32_t address, const std::string& varName)
 {
 	assert(GETSEGNUM(address) == 0);
@@ -757,10 +809,16 @@ Declaration* ZFile::GetDeclaration(offset_t address) const
 
 Declaration* ZFile::GetDeclarationRanged(offset_t address) const
 {
-	for (const auto decl : declarations)
+	// Only the declarations starting less than maxDeclarationSize bytes before address can contain
+	// it, so there's no need to look at the ones before them.
+	auto decl = declarations.begin();
+	if (address >= maxDeclarationSize)
+		decl = declarations.upper_bound(address - maxDeclarationSize);
+
+	for (; decl != declarations.end() && decl->first <= address; decl++)
 	{
-		if (address >= decl.first && address < decl.first + decl.second->size)
-			return decl.second;
+		if (address < decl->first + decl->second->size)
+			return decl->second;
 	}
 
 	return nullptr;
@@ -788,12 +846,16 @@ size_t ZFile::GetDeclarationSizeFromNeighbor(uint32_t declarationAddress)
 
 void ZFile::GenerateSourceFiles()
 {
-	std::string sourceOutput;
+	ProfileScope profileScope("GenerateSourceFiles");
 
-	sourceOutput += "#include \"ultra64.h\"\n";
-	sourceOutput += "#include \"z64.h\"\n";
-	sourceOutput += "#include \"macros.h\"\n";
-	sourceOutput += GetHeaderInclude();
+	// The declarations are written to the formatter as they are generated, so the only full copy
+	// of the file kept in memory is the formatted one.
+	OutputFormatter formatter;
+
+	formatter.Write("#include \"ultra64.h\"\n");
+	formatter.Write("#include \"z64.h\"\n");
+	formatter.Write("#include \"macros.h\"\n");
+	formatter.Write(GetHeaderInclude());
 
 	bool hasZRoom = false;
 	for (const auto& res : resources)
@@ -809,10 +871,10 @@ void ZFile::GenerateSourceFiles()
 
 	if (hasZRoom)
 	{
-		sourceOutput += GetZRoomHeaderInclude();
+		formatter.Write(GetZRoomHeaderInclude());
 	}
 
-	sourceOutput += GetExternalFileHeaderInclude();
+	formatter.Write(GetExternalFileHeaderInclude());
 
 	GeneratePlaceholderDeclarations();
 
@@ -820,20 +882,19 @@ void ZFile::GenerateSourceFiles()
 	for (size_t i = 0; i < resources.size(); i++)
 	{
 		ZResource* res = resources.at(i);
+		ProfileScope resProfileScope("GetSourceOutputCode", res);
 		res->GetSourceOutputCode(name);
 	}
 
-	sourceOutput += ProcessDeclarations();
+	ProcessDeclarations(formatter);
 
 	fs::path outPath = GetSourceOutputFolderPath() / outName.stem().concat(".c");
 
 	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 		printf("Writing C file: %s\n", outPath.c_str());
 
-	OutputFormatter formatter;
-	formatter.Write(sourceOutput);
-
-	File::WriteAllText(outPath, formatter.GetOutput());
+	File::WriteAllTextIfChanged(outPath, formatter.GetOutput());
+	Globals::Instance->outputFiles.push_back(outPath);
 
 	GenerateSourceHeaderFiles();
 }
@@ -861,7 +922,7 @@ void ZFile::GenerateSourceHeaderFiles()
 		formatter.Write(sym.second->GetSourceOutputHeader(""));
 	}
 
-	formatter.Write(ProcessExterns());
+	ProcessExterns(formatter);
 
 	formatter.Write("#endif\n");
 
@@ -870,7 +931,8 @@ void ZFile::GenerateSourceHeaderFiles()
 	if (Globals::Instance->verbosity >= VerbosityLevel::VERBOSITY_INFO)
 		printf("Writing H file: %s\n", headerFilename.c_str());
 
-	File::WriteAllText(headerFilename, formatter.GetOutput());
+	File::WriteAllTextIfChanged(headerFilename, formatter.GetOutput());
+	Globals::Instance->outputFiles.push_back(headerFilename);
 }
 
 std::string ZFile::GetHeaderInclude() const
@@ -950,9 +1012,26 @@ ZTexture* ZFile::GetTextureResource(uint32_t offset) const
 	return nullptr;
 }
 
+void ZFile::AddDListResource(uint32_t offset, ZDisplayList* dList)
+{
+	// Keep the first list parsed at this offset
+	dListResources.try_emplace(offset, dList);
+}
+
+ZDisplayList* ZFile::GetDListResource(uint32_t offset) const
+{
+	auto dList = dListResources.find(offset);
+	if (dList != dListResources.end())
+		return dList->second;
+
+	return nullptr;
+}
+
 void ZFile::AddSymbolResource(uint32_t offset, ZSymbol* sym)
 {
 	symbolResources[offset] = sym;
+	maxSymbolResourceSize = std::max(maxSymbolResourceSize, sym->GetRawDataSize());
+	Globals::Instance->AddSegmentedRef(GetSegmentedAddress(offset), sym->GetRawDataSize(), this);
 }
 
 ZSymbol* ZFile::GetSymbolResource(uint32_t offset) const
@@ -966,10 +1045,15 @@ ZSymbol* ZFile::GetSymbolResource(uint32_t offset) const
 
 ZSymbol* ZFile::GetSymbolResourceRanged(uint32_t offset) const
 {
-	for (const auto decl : symbolResources)
+	// Same as GetDeclarationRanged
+	auto sym = symbolResources.begin();
+	if (offset >= maxSymbolResourceSize)
+		sym = symbolResources.upper_bound(offset - maxSymbolResourceSize);
+
+	for (; sym != symbolResources.end() && sym->first <= offset; sym++)
 	{
-		if (offset >= decl.first && offset < decl.first + decl.second->GetRawDataSize())
-			return decl.second;
+		if (offset < sym->first + sym->second->GetRawDataSize())
+			return sym->second;
 	}
 
 	return nullptr;
@@ -1010,12 +1094,10 @@ void ZFile::RegisterNode(std::string nodeName, ZResourceFactoryFunc* nodeFunc)
 	(*nodeMap)[nodeName] = nodeFunc;
 }
 
-std::string ZFile::ProcessDeclarations()
+void ZFile::ProcessDeclarations(OutputFormatter& formatter)
 {
-	std::string output;
-
 	if (declarations.size() == 0)
-		return output;
+		return;
 
 	defines += ProcessTextureIntersections(name);
 
@@ -1038,10 +1120,10 @@ std::string ZFile::ProcessDeclarations()
 	// First, handle the prototypes (static only for now)
 	for (std::pair<uint32_t, Declaration*> item : declarations)
 	{
-		output += item.second->GetStaticForwardDeclarationStr();
+		formatter.Write(item.second->GetStaticForwardDeclarationStr());
 	}
 
-	output += "\n";
+	formatter.Write("\n");
 
 	// Next, output the actual declarations
 	for (const auto& item : declarations)
@@ -1062,20 +1144,20 @@ std::string ZFile::ProcessDeclarations()
 					extType = "vtx";
 
 				auto filepath = outputPath / item.second->declName;
-				File::WriteAllText(
-					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), extType.c_str()),
-					item.second->declBody);
+				std::string incPath =
+					StringHelper::Sprintf("%s.%s.inc", filepath.string().c_str(), extType.c_str());
+
+				File::WriteAllTextIfChanged(incPath, item.second->declBody);
+				Globals::Instance->outputFiles.push_back(incPath);
 			}
 
-			output += item.second->GetExternalDeclarationStr();
+			formatter.Write(item.second->GetExternalDeclarationStr());
 		}
 		else if (item.second->declType != "")
 		{
-			output += item.second->GetNormalDeclarationStr();
+			formatter.Write(item.second->GetNormalDeclarationStr());
 		}
 	}
-
-	return output;
 }
 
 void ZFile::MergeNeighboringDeclarations()
@@ -1105,6 +1187,7 @@ void ZFile::MergeNeighboringDeclarations()
 						if (sizeDiff == 0)
 						{
 							lastItem.second->size += curItem.second->size;
+							IndexDeclaration(lastItem.second);
 							lastItem.second->arrayItemCnt += curItem.second->arrayItemCnt;
 							lastItem.second->declBody += "\n" + curItem.second->declBody;
 							declarations.erase(curItem.first);
@@ -1149,9 +1232,8 @@ void ZFile::ProcessDeclarationText(Declaration* decl)
 	}
 }
 
-std::string ZFile::ProcessExterns()
+void ZFile::ProcessExterns(OutputFormatter& formatter)
 {
-	std::string output = "";
 	bool hadDefines = true;  // Previous declaration included defines.
 
 	for (const auto& item : declarations)
@@ -1165,21 +1247,19 @@ std::string ZFile::ProcessExterns()
 		// Add a newline above if previous has no defines and this one does.
 		if (!hadDefines && (itemDefines.length() > 0))
 		{
-			output.push_back('\n');
+			formatter.Write("\n");
 		}
-		output += item.second->GetExternStr();
-		output += itemDefines;
+		formatter.Write(item.second->GetExternStr());
+		formatter.Write(itemDefines);
 
 		// Newline below if this one has defines.
 		if ((hadDefines = (itemDefines.length() > 0)))
 		{
-			output.push_back('\n');
+			formatter.Write("\n");
 		}
 	}
 
-	output += defines;
-
-	return output;
+	formatter.Write(defines);
 }
 
 std::string ZFile::ProcessTextureIntersections([[maybe_unused]] const std::string& prefix)
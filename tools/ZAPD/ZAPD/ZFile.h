@@ -3,10 +3,15 @@
 #include <string>
 #include <vector>
 
+#include "Utils/ByteSpan.h"
+#include "Utils/MappedFile.h"
 #include "ZSymbol.h"
 #include "ZTexture.h"
 #include "tinyxml2.h"
 
+class OutputFormatter;
+class ZDisplayList;
+
 enum class ZFileMode
 {
 	BuildTexture,
@@ -50,7 +55,8 @@ public:
 	std::string GetOutName() const;
 	ZFileMode GetMode() const;
 	const fs::path& GetXmlFilePath() const;
-	const std::vector<uint8_t>& GetRawData() const;
+	fs::path GetBinaryFilePath() const;
+	ByteSpan GetRawData() const;
 	void ExtractResources();
 	void BuildSourceFile();
 	void AddResource(ZResource* res);
@@ -100,6 +106,9 @@ public:
 	void AddTextureResource(uint32_t offset, ZTexture* tex);
 	ZTexture* GetTextureResource(uint32_t offset) const;
 
+	void AddDListResource(uint32_t offset, ZDisplayList* dList);
+	ZDisplayList* GetDListResource(uint32_t offset) const;
+
 	void AddSymbolResource(uint32_t offset, ZSymbol* sym);
 	ZSymbol* GetSymbolResource(uint32_t offset) const;
 	ZSymbol* GetSymbolResourceRanged(uint32_t offset) const;
@@ -113,7 +122,9 @@ public:
 	static void RegisterNode(std::string nodeName, ZResourceFactoryFunc* nodeFunc);
 
 protected:
-	std::vector<uint8_t> rawData;
+	// The binary file is mapped rather than read, see MappedFile
+	MappedFile rawDataFile;
+	ByteSpan rawData;
 	std::string name;
 	fs::path outName = "";
 	fs::path basePath;
@@ -125,6 +136,13 @@ protected:
 	// so ZFile shouldn't delete/free those textures.
 	std::map<uint32_t, ZTexture*> texturesResources;
 	std::map<uint32_t, ZSymbol*> symbolResources;
+	// Display lists parsed from this file, borrowed like the textures. Lets the lists called from
+	// several places be scanned and parsed only once.
+	std::map<uint32_t, ZDisplayList*> dListResources;
+	// Upper bounds of the sizes of the declarations and symbols, so the ranged lookups only have to
+	// check the few entries starting right before the searched address.
+	size_t maxDeclarationSize = 0;
+	size_t maxSymbolResourceSize = 0;
 	ZFileMode mode = ZFileMode::Invalid;
 
 	ZFile();
@@ -133,10 +151,12 @@ protected:
 	void GenerateSourceFiles();
 	void GenerateSourceHeaderFiles();
 	bool DeclarationSanityChecks(uint32_t address, const std::string& varName);
-	std::string ProcessDeclarations();
+	void IndexDeclaration(Declaration* decl);
+	segptr_t GetSegmentedAddress(offset_t offset) const;
+	void ProcessDeclarations(OutputFormatter& formatter);
 	void MergeNeighboringDeclarations();
 	void ProcessDeclarationText(Declaration* decl);
-	std::string ProcessExterns();
+	void ProcessExterns(OutputFormatter& formatter);
 
 	std::string ProcessTextureIntersections(const std::string& prefix);
 	void HandleUnaccountedData();
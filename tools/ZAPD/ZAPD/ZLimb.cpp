@@ -399,7 +399,7 @@ void ZLimb::DeclareDList(segptr_t dListSegmentedPtr, const std::string& prefix,
 		return;
 
 	int32_t dlistLength = ZDisplayList::GetDListLength(
-		parent->GetRawData(), dlistOffset,
+		parent, dlistOffset,
 		Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
 	ZDisplayList* dlist = new ZDisplayList(parent);
 	dlist->ExtractFromBinary(dlistOffset, dlistLength);
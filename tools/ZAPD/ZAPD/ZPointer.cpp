@@ -22,7 +22,7 @@ void ZPointer::ParseXML(tinyxml2::XMLElement* reader)
 
 void ZPointer::ParseRawData()
 {
-	auto& rawData = parent->GetRawData();
+	const auto& rawData = parent->GetRawData();
 
 	ptr = BitConverter::ToUInt32BE(rawData, rawDataIndex);
 }
@@ -337,3 +337,14 @@ offset_t Seg2Filespace(segptr_t segmentedAddress, uint32_t parentBaseAddress)
 
 	return currentPtr;
 }
+
+const char* GetResourceTypeName(ZResourceType resourceType)
+{
+	static const char* const names[] = {
+#define ZRESOURCE_TYPE_NAME(type) #type,
+		ZRESOURCE_TYPES(ZRESOURCE_TYPE_NAME)
+#undef ZRESOURCE_TYPE_NAME
+	};
+
+	return names[static_cast<size_t>(resourceType)];
+}
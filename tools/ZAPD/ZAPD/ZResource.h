@@ -7,6 +7,7 @@
 #include <vector>
 #include "Declaration.h"
 #include "Utils/BinaryWriter.h"
+#include "Utils/ByteSpan.h"
 #include "Utils/Directory.h"
 #include "tinyxml2.h"
 
@@ -22,41 +23,50 @@
 
 class ZFile;
 
+// Every resource type, listed once so the enum and the names of its values can't drift apart
+#define ZRESOURCE_TYPES(X)                                                                         \
+	X(Error)                                                                                       \
+	X(ActorList)                                                                                   \
+	X(Animation)                                                                                   \
+	X(Array)                                                                                       \
+	X(AltHeader)                                                                                   \
+	X(Background)                                                                                  \
+	X(Blob)                                                                                        \
+	X(CollisionHeader)                                                                             \
+	X(CollisionPoly)                                                                               \
+	X(Cutscene)                                                                                    \
+	X(DisplayList)                                                                                 \
+	X(Limb)                                                                                        \
+	X(LimbTable)                                                                                   \
+	X(Mtx)                                                                                         \
+	X(Path)                                                                                        \
+	X(PlayerAnimationData)                                                                         \
+	X(Pointer)                                                                                     \
+	X(Room)                                                                                        \
+	X(RoomCommand)                                                                                 \
+	X(Scalar)                                                                                      \
+	X(Scene)                                                                                       \
+	X(Skeleton)                                                                                    \
+	X(String)                                                                                      \
+	X(SurfaceType)                                                                                 \
+	X(Symbol)                                                                                      \
+	X(Texture)                                                                                     \
+	X(TextureAnimation)                                                                            \
+	X(TextureAnimationParams)                                                                      \
+	X(Vector)                                                                                      \
+	X(Vertex)                                                                                      \
+	X(Waterbox)
+
 enum class ZResourceType
 {
-	Error,
-	ActorList,
-	Animation,
-	Array,
-	AltHeader,
-	Background,
-	Blob,
-	CollisionHeader,
-	CollisionPoly,
-	Cutscene,
-	DisplayList,
-	Limb,
-	LimbTable,
-	Mtx,
-	Path,
-	PlayerAnimationData,
-	Pointer,
-	Room,
-	RoomCommand,
-	Scalar,
-	Scene,
-	Skeleton,
-	String,
-	SurfaceType,
-	Symbol,
-	Texture,
-	TextureAnimation,
-	TextureAnimationParams,
-	Vector,
-	Vertex,
-	Waterbox,
+#define ZRESOURCE_TYPE_ENUM(type) type,
+	ZRESOURCE_TYPES(ZRESOURCE_TYPE_ENUM)
+#undef ZRESOURCE_TYPE_ENUM
 };
 
+// The name of a resource type, as written in the enum
+const char* GetResourceTypeName(ZResourceType resourceType);
+
 class ResourceAttribute
 {
 public:
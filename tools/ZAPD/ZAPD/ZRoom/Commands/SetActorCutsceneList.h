@@ -17,7 +17,7 @@ protected:
 	uint8_t letterboxSize;
 
 public:
-	ActorCutsceneEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	ActorCutsceneEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 	std::string GetSourceTypeName() const;
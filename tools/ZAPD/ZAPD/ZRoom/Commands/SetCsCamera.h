@@ -6,7 +6,7 @@
 class CsCameraEntry
 {
 public:
-	CsCameraEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CsCameraEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetSourceTypeName() const;
 	int32_t GetRawDataSize() const;
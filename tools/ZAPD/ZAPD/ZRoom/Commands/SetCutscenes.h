@@ -6,7 +6,7 @@
 class CutsceneEntry
 {
 public:
-	CutsceneEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	CutsceneEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	segptr_t segmentPtr;
 	uint16_t exit;
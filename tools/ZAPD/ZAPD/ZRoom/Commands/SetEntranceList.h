@@ -8,7 +8,7 @@ public:
 	uint8_t startPositionIndex;
 	uint8_t roomToLoad;
 
-	EntranceEntry(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex);
+	EntranceEntry(ByteSpan rawData, uint32_t rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 };
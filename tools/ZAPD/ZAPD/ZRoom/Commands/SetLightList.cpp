@@ -68,7 +68,7 @@ RoomCommand SetLightList::GetRoomCommand() const
 	return RoomCommand::SetLightList;
 }
 
-LightInfo::LightInfo(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+LightInfo::LightInfo(ByteSpan rawData, uint32_t rawDataIndex)
 {
 	type = BitConverter::ToUInt8BE(rawData, rawDataIndex + 0);
 	x = BitConverter::ToInt16BE(rawData, rawDataIndex + 2);
@@ -60,7 +60,7 @@ RoomCommand SetLightingSettings::GetRoomCommand() const
 	return RoomCommand::SetLightingSettings;
 }
 
-LightingSettings::LightingSettings(const std::vector<uint8_t>& rawData, uint32_t rawDataIndex)
+LightingSettings::LightingSettings(ByteSpan rawData, uint32_t rawDataIndex)
 {
 	ambientClrR = rawData.at(rawDataIndex + 0);
 	ambientClrG = rawData.at(rawDataIndex + 1);
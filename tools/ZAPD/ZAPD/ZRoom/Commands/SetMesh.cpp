@@ -18,7 +18,7 @@ SetMesh::SetMesh(ZFile* nParent) : ZRoomCommand(nParent)
 void SetMesh::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
-	auto& parentRawData = parent->GetRawData();
+	const auto& parentRawData = parent->GetRawData();
 	meshHeaderType = parentRawData.at(segmentOffset);
 
 	switch (meshHeaderType)
@@ -199,7 +199,7 @@ ZDisplayList* PolygonDlist::MakeDlist(segptr_t ptr, [[maybe_unused]] const std::
 	uint32_t dlistAddress = Seg2Filespace(ptr, parent->baseAddress);
 
 	int32_t dlistLength = ZDisplayList::GetDListLength(
-		parent->GetRawData(), dlistAddress,
+		parent, dlistAddress,
 		Globals::Instance->game == ZGame::OOT_SW97 ? DListType::F3DEX : DListType::F3DZEX);
 	ZDisplayList* dlist = new ZDisplayList(parent);
 	parent->AddResource(dlist);
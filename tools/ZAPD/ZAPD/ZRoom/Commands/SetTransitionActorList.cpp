@@ -68,7 +68,7 @@ RoomCommand SetTransitionActorList::GetRoomCommand() const
 	return RoomCommand::SetTransitionActorList;
 }
 
-TransitionActorEntry::TransitionActorEntry(const std::vector<uint8_t>& rawData, int rawDataIndex)
+TransitionActorEntry::TransitionActorEntry(ByteSpan rawData, int rawDataIndex)
 {
 	frontObjectRoom = rawData[rawDataIndex + 0];
 	frontTransitionReaction = rawData[rawDataIndex + 1];
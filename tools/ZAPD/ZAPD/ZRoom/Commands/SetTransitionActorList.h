@@ -14,7 +14,7 @@ public:
 	int16_t rotY;
 	uint16_t initVar;
 
-	TransitionActorEntry(const std::vector<uint8_t>& rawData, int rawDataIndex);
+	TransitionActorEntry(ByteSpan rawData, int rawDataIndex);
 
 	std::string GetBodySourceCode() const;
 };
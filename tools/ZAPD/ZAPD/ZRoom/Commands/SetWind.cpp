@@ -8,7 +8,7 @@ SetWind::SetWind(ZFile* nParent) : ZRoomCommand(nParent)
 void SetWind::ParseRawData()
 {
 	ZRoomCommand::ParseRawData();
-	auto& parentRawData = parent->GetRawData();
+	const auto& parentRawData = parent->GetRawData();
 	windWest = parentRawData.at(rawDataIndex + 0x04);
 	windVertical = parentRawData.at(rawDataIndex + 0x05);
 	windSouth = parentRawData.at(rawDataIndex + 0x06);
@@ -18,7 +18,7 @@ void ZRoomCommand::ExtractCommandFromRoom(ZRoom* nZRoom, uint32_t nRawDataIndex)
 
 void ZRoomCommand::ParseRawData()
 {
-	auto& parentRawData = parent->GetRawData();
+	const auto& parentRawData = parent->GetRawData();
 	cmdID = static_cast<RoomCommand>(parentRawData.at(rawDataIndex));
 	cmdAddress = rawDataIndex;
 
@@ -3,9 +3,21 @@
 #include "Globals.h"
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
+#include "WarningHandler.h"
 
 REGISTER_ZFILENODE(SurfaceType, ZSurfaceType);
 
+void SurfaceTypeData::Decode(const uint8_t* rawData)
+{
+	data[0] = BitConverter::ToUInt32BE(rawData + 0);
+	data[1] = BitConverter::ToUInt32BE(rawData + 4);
+}
+
+std::string SurfaceTypeData::GetBodySourceCode() const
+{
+	return StringHelper::Sprintf("{0x%08X, 0x%08X}", data[0], data[1]);
+}
+
 ZSurfaceType::ZSurfaceType(ZFile* nParent) : ZResource(nParent)
 {
 }
@@ -18,8 +30,11 @@ void ZSurfaceType::ParseRawData()
 {
 	const auto& rawData = parent->GetRawData();
 
-	data[0] = BitConverter::ToUInt32BE(rawData, rawDataIndex + 0);
-	data[1] = BitConverter::ToUInt32BE(rawData, rawDataIndex + 4);
+	if (rawDataIndex + GetRawDataSize() > rawData.size())
+		HANDLE_ERROR_RESOURCE(WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+		                      "SurfaceType extends past the end of the file", "");
+
+	surfaceType.Decode(rawData.data() + rawDataIndex);
 }
 
 void ZSurfaceType::DeclareReferences(const std::string& prefix)
@@ -36,7 +51,7 @@ void ZSurfaceType::DeclareReferences(const std::string& prefix)
 
 std::string ZSurfaceType::GetBodySourceCode() const
 {
-	return StringHelper::Sprintf("{0x%08X, 0x%08X}", data[0], data[1]);
+	return surfaceType.GetBodySourceCode();
 }
 
 std::string ZSurfaceType::GetDefaultName(const std::string& prefix) const
@@ -4,11 +4,24 @@
 #include "ZFile.h"
 #include "ZResource.h"
 
-class ZSurfaceType : public ZResource
+/**
+ * The two words of a SurfaceType.
+ */
+class SurfaceTypeData
 {
 public:
 	std::array<uint32_t, 2> data;
 
+	// Decodes the 8 big-endian bytes at `rawData`.
+	void Decode(const uint8_t* rawData);
+	std::string GetBodySourceCode() const;
+};
+
+class ZSurfaceType : public ZResource
+{
+public:
+	SurfaceTypeData surfaceType;
+
 	ZSurfaceType(ZFile* nParent);
 	~ZSurfaceType();
 
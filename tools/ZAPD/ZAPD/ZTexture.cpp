@@ -1,6 +1,7 @@
 #include "ZTexture.h"
 
 #include <cassert>
+#include <cstring>
 
 #include "CRC32.h"
 #include "Globals.h"
@@ -12,6 +13,19 @@
 
 REGISTER_ZFILENODE(Texture, ZTexture);
 
+// Expansion of N-bit color channels to 8 bits, replicating the high bits into the low ones
+static constexpr uint8_t sExpand3To8[8] = {
+	0x00, 0x24, 0x49, 0x6D, 0x92, 0xB6, 0xDB, 0xFF,
+};
+static constexpr uint8_t sExpand4To8[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
+};
+static constexpr uint8_t sExpand5To8[32] = {
+	0x00, 0x08, 0x10, 0x18, 0x21, 0x29, 0x31, 0x39, 0x42, 0x4A, 0x52, 0x5A, 0x63, 0x6B, 0x73, 0x7B,
+	0x84, 0x8C, 0x94, 0x9C, 0xA5, 0xAD, 0xB5, 0xBD, 0xC6, 0xCE, 0xD6, 0xDE, 0xE7, 0xEF, 0xF7, 0xFF,
+};
+
 ZTexture::ZTexture(ZFile* nParent) : ZResource(nParent)
 {
 	width = 0;
@@ -134,6 +148,16 @@ void ZTexture::ParseRawData()
 	if (rawDataIndex % 8 != 0)
 		dWordAligned = false;
 
+	// The codecs below read the texels without bounds checks
+	if (rawDataIndex + GetRawDataSize() > parent->GetRawData().size())
+	{
+		std::string errorHeader =
+			StringHelper::Sprintf("texture extends past the end of the file (0x%zX bytes)",
+		                          parent->GetRawData().size());
+		HANDLE_ERROR_RESOURCE(WarningType::InvalidExtractedData, parent, this, rawDataIndex,
+		                      errorHeader, "");
+	}
+
 	switch (format)
 	{
 	case TextureType::RGBA16bpp:
@@ -215,20 +239,20 @@ void ZTexture::ParseRawDataLate()
 void ZTexture::ConvertN64ToBitmap_RGBA16()
 {
 	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x++)
+		uint8_t* dst = textureData.GetRow(y);
+
+		for (size_t x = 0; x < width; x++, src += 2, dst += 4)
 		{
-			int32_t pos = rawDataIndex + ((y * width) + x) * 2;
-			uint16_t data = parentRawData.at(pos + 1) | (parentRawData.at(pos) << 8);
-			uint8_t r = (data & 0xF800) >> 11;
-			uint8_t g = (data & 0x07C0) >> 6;
-			uint8_t b = (data & 0x003E) >> 1;
-			uint8_t alpha = data & 0x01;
-
-			textureData.SetRGBPixel(y, x, (r << 3) | (r >> 2), (g << 3) | (g >> 2),
-			                        (b << 3) | (b >> 2), alpha * 255);
+			uint16_t data = (src[0] << 8) | src[1];
+
+			dst[0] = sExpand5To8[(data >> 11) & 0x1F];
+			dst[1] = sExpand5To8[(data >> 6) & 0x1F];
+			dst[2] = sExpand5To8[(data >> 1) & 0x1F];
+			dst[3] = (data & 0x01) ? 255 : 0;
 		}
 	}
 }
@@ -236,42 +260,26 @@ void ZTexture::ConvertN64ToBitmap_RGBA16()
 void ZTexture::ConvertN64ToBitmap_RGBA32()
 {
 	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 4;
-			uint8_t r = parentRawData.at(pos + 0);
-			uint8_t g = parentRawData.at(pos + 1);
-			uint8_t b = parentRawData.at(pos + 2);
-			uint8_t alpha = parentRawData.at(pos + 3);
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
 
-			textureData.SetRGBPixel(y, x, r, g, b, alpha);
-		}
-	}
+	// Same layout as the RGBA image, whose rows are contiguous
+	memcpy(textureData.GetImageData(), src, width * height * 4);
 }
 
 void ZTexture::ConvertN64ToBitmap_Grayscale4()
 {
 	textureData.InitEmptyRGBImage(width, height, false);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint8_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t grayscale = 0;
+		uint8_t* dst = textureData.GetRow(y);
 
-				if (i == 0)
-					grayscale = parentRawData.at(pos) & 0xF0;
-				else
-					grayscale = (parentRawData.at(pos) & 0x0F) << 4;
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, dst += 3)
+		{
+			uint8_t grayscale = ((src[texel / 2] >> ((~texel & 1) * 4)) & 0x0F) << 4;
 
-				textureData.SetGrayscalePixel(y, x + i, (grayscale << 4) | grayscale);
-			}
+			dst[0] = dst[1] = dst[2] = grayscale;
 		}
 	}
 }
@@ -279,42 +287,32 @@ void ZTexture::ConvertN64ToBitmap_Grayscale4()
 void ZTexture::ConvertN64ToBitmap_Grayscale8()
 {
 	textureData.InitEmptyRGBImage(width, height, false);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
+		uint8_t* dst = textureData.GetRow(y);
 
-			textureData.SetGrayscalePixel(y, x, parentRawData.at(pos));
-		}
+		for (size_t x = 0; x < width; x++, src++, dst += 3)
+			dst[0] = dst[1] = dst[2] = *src;
 	}
 }
 
 void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha4()
 {
 	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t data = 0;
-
-				if (i == 0)
-					data = (parentRawData.at(pos) & 0xF0) >> 4;
-				else
-					data = parentRawData.at(pos) & 0x0F;
+		uint8_t* dst = textureData.GetRow(y);
 
-				uint8_t grayscale = data & 0b1110;
-				grayscale = (grayscale << 4) | (grayscale << 1) | (grayscale >> 2);
-				uint8_t alpha = (data & 0x01) ? 255 : 0;
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, dst += 4)
+		{
+			uint8_t data = (src[texel / 2] >> ((~texel & 1) * 4)) & 0x0F;
 
-				textureData.SetGrayscalePixel(y, x + i, grayscale, alpha);
-			}
+			dst[0] = dst[1] = dst[2] = sExpand3To8[data >> 1];
+			dst[3] = (data & 0x01) ? 255 : 0;
 		}
 	}
 }
@@ -322,21 +320,16 @@ void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha4()
 void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha8()
 {
 	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
-			uint8_t pixel = parentRawData.at(pos);
-			uint8_t data = (pixel >> 4) & 0xF;
-
-			data = (data << 4) | data;
-			uint8_t grayscale = data;
-			uint8_t alpha = (pixel & 0xF);
-			alpha = (alpha << 4) | alpha;
+		uint8_t* dst = textureData.GetRow(y);
 
-			textureData.SetGrayscalePixel(y, x, grayscale, alpha);
+		for (size_t x = 0; x < width; x++, src++, dst += 4)
+		{
+			dst[0] = dst[1] = dst[2] = sExpand4To8[*src >> 4];
+			dst[3] = sExpand4To8[*src & 0x0F];
 		}
 	}
 }
@@ -344,16 +337,16 @@ void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha8()
 void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha16()
 {
 	textureData.InitEmptyRGBImage(width, height, true);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 2;
-			uint8_t grayscale = parentRawData.at(pos + 0);
-			uint8_t alpha = parentRawData.at(pos + 1);
+		uint8_t* dst = textureData.GetRow(y);
 
-			textureData.SetGrayscalePixel(y, x, grayscale, alpha);
+		for (size_t x = 0; x < width; x++, src += 2, dst += 4)
+		{
+			dst[0] = dst[1] = dst[2] = src[0];
+			dst[3] = src[1];
 		}
 	}
 }
@@ -361,40 +354,46 @@ void ZTexture::ConvertN64ToBitmap_GrayscaleAlpha16()
 void ZTexture::ConvertN64ToBitmap_Palette4()
 {
 	textureData.InitEmptyPaletteImage(width, height);
-	const auto& parentRawData = parent->GetRawData();
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+	bool usedIndices[16] = {};
+
 	for (size_t y = 0; y < height; y++)
 	{
-		for (size_t x = 0; x < width; x += 2)
-		{
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				size_t pos = rawDataIndex + ((y * width) + x) / 2;
-				uint8_t paletteIndex = 0;
+		uint8_t* dst = textureData.GetRow(y);
 
-				if (i == 0)
-					paletteIndex = (parentRawData.at(pos) & 0xF0) >> 4;
-				else
-					paletteIndex = (parentRawData.at(pos) & 0x0F);
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, dst++)
+		{
+			uint8_t paletteIndex = (src[texel / 2] >> ((~texel & 1) * 4)) & 0x0F;
 
-				textureData.SetIndexedPixel(y, x + i, paletteIndex, paletteIndex * 16);
-			}
+			*dst = paletteIndex;
+			usedIndices[paletteIndex] = true;
 		}
 	}
+
+	// Placeholder grayscale palette, replaced by the TLUT if the texture has one
+	for (size_t i = 0; i < 16; i++)
+	{
+		if (usedIndices[i])
+			textureData.SetPaletteIndex(i, i * 16, i * 16, i * 16, 255);
+	}
 }
 
 void ZTexture::ConvertN64ToBitmap_Palette8()
 {
 	textureData.InitEmptyPaletteImage(width, height);
-	const auto& parentRawData = parent->GetRawData();
-	for (size_t y = 0; y < height; y++)
-	{
-		for (size_t x = 0; x < width; x++)
-		{
-			size_t pos = rawDataIndex + ((y * width) + x) * 1;
-			uint8_t grayscale = parentRawData.at(pos);
+	const uint8_t* src = parent->GetRawData().data() + rawDataIndex;
+	bool usedIndices[256] = {};
 
-			textureData.SetIndexedPixel(y, x, grayscale, grayscale);
-		}
+	memcpy(textureData.GetImageData(), src, width * height);
+
+	for (size_t i = 0; i < width * height; i++)
+		usedIndices[src[i]] = true;
+
+	// Placeholder grayscale palette, replaced by the TLUT if the texture has one
+	for (size_t i = 0; i < 256; i++)
+	{
+		if (usedIndices[i])
+			textureData.SetPaletteIndex(i, i, i, i, 255);
 	}
 }
 
@@ -469,161 +468,157 @@ void ZTexture::PrepareRawDataFromFile(const fs::path& pngFilePath)
 
 void ZTexture::ConvertBitmapToN64_RGBA16()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 2;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-
-			uint8_t r = pixel.r >> 3;
-			uint8_t g = pixel.g >> 3;
-			uint8_t b = pixel.b >> 3;
+	size_t stride = textureData.GetPixelStride();
+	bool hasAlpha = textureData.HasAlphaChannel();
+	uint8_t* dst = textureDataRaw.data();
 
-			uint8_t alphaBit = pixel.a != 0;
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-			uint16_t data = (r << 11) | (g << 6) | (b << 1) | alphaBit;
+		for (size_t x = 0; x < width; x++, src += stride, dst += 2)
+		{
+			uint8_t alphaBit = hasAlpha && src[3] != 0;
+			uint16_t data = ((src[0] >> 3) << 11) | ((src[1] >> 3) << 6) | ((src[2] >> 3) << 1) |
+			                alphaBit;
 
-			textureDataRaw[pos + 0] = (data & 0xFF00) >> 8;
-			textureDataRaw[pos + 1] = (data & 0x00FF);
+			dst[0] = data >> 8;
+			dst[1] = data & 0xFF;
 		}
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_RGBA32()
 {
-	for (uint16_t y = 0; y < height; y++)
+	size_t stride = textureData.GetPixelStride();
+	bool hasAlpha = textureData.HasAlphaChannel();
+	uint8_t* dst = textureDataRaw.data();
+
+	if (hasAlpha && textureData.GetRowStride() == width * 4)
 	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 4;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
+		memcpy(dst, textureData.GetImageData(), width * height * 4);
+		return;
+	}
+
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-			textureDataRaw[pos + 0] = pixel.r;
-			textureDataRaw[pos + 1] = pixel.g;
-			textureDataRaw[pos + 2] = pixel.b;
-			textureDataRaw[pos + 3] = pixel.a;
+		for (size_t x = 0; x < width; x++, src += stride, dst += 4)
+		{
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			dst[3] = hasAlpha ? src[3] : 0;
 		}
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_Grayscale4()
 {
-	for (uint16_t y = 0; y < height; y++)
+	size_t stride = textureData.GetPixelStride();
+	uint8_t* dst = textureDataRaw.data();
+
+	for (size_t y = 0; y < height; y++)
 	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
-			uint8_t r1 = textureData.GetPixel(y, x).r;
-			uint8_t r2 = textureData.GetPixel(y, x + 1).r;
+		const uint8_t* src = textureData.GetRow(y);
 
-			textureDataRaw[pos] = (uint8_t)(((r1 / 16) << 4) + (r2 / 16));
-		}
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, src += stride)
+			dst[texel / 2] |= (src[0] >> 4) << ((~texel & 1) * 4);
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_Grayscale8()
 {
-	for (uint16_t y = 0; y < height; y++)
+	size_t stride = textureData.GetPixelStride();
+	uint8_t* dst = textureDataRaw.data();
+
+	for (size_t y = 0; y < height; y++)
 	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = (y * width) + x;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
-			textureDataRaw[pos] = pixel.r;
-		}
+		const uint8_t* src = textureData.GetRow(y);
+
+		for (size_t x = 0; x < width; x++, src += stride, dst++)
+			*dst = src[0];
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_GrayscaleAlpha4()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
-			uint8_t data = 0;
+	size_t stride = textureData.GetPixelStride();
+	bool hasAlpha = textureData.HasAlphaChannel();
+	uint8_t* dst = textureDataRaw.data();
 
-			for (uint16_t i = 0; i < 2; i++)
-			{
-				RGBAPixel pixel = textureData.GetPixel(y, x + i);
-				uint8_t cR = pixel.r;
-				uint8_t alphaBit = pixel.a != 0;
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-				if (i == 0)
-					data = (((cR >> 5) << 1) | alphaBit) << 4;
-				else
-					data |= ((cR >> 5) << 1) | alphaBit;
-			}
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, src += stride)
+		{
+			uint8_t alphaBit = hasAlpha && src[3] != 0;
 
-			textureDataRaw[pos] = data;
+			dst[texel / 2] |= (((src[0] >> 5) << 1) | alphaBit) << ((~texel & 1) * 4);
 		}
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_GrayscaleAlpha8()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 1;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
+	size_t stride = textureData.GetPixelStride();
+	bool hasAlpha = textureData.HasAlphaChannel();
+	uint8_t* dst = textureDataRaw.data();
 
-			uint8_t r = (pixel.r >> 4) & 0xF;
-			uint8_t a = (pixel.a >> 4) & 0xF;
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-			textureDataRaw[pos] = (r << 4) | a;
-		}
+		for (size_t x = 0; x < width; x++, src += stride, dst++)
+			*dst = (src[0] & 0xF0) | (hasAlpha ? src[3] >> 4 : 0);
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_GrayscaleAlpha16()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x) * 2;
-			RGBAPixel pixel = textureData.GetPixel(y, x);
+	size_t stride = textureData.GetPixelStride();
+	bool hasAlpha = textureData.HasAlphaChannel();
+	uint8_t* dst = textureDataRaw.data();
 
-			uint8_t cR = pixel.r;
-			uint8_t aR = pixel.a;
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-			textureDataRaw[pos + 0] = cR;
-			textureDataRaw[pos + 1] = aR;
+		for (size_t x = 0; x < width; x++, src += stride, dst += 2)
+		{
+			dst[0] = src[0];
+			dst[1] = hasAlpha ? src[3] : 0;
 		}
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_Palette4()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x += 2)
-		{
-			size_t pos = ((y * width) + x) / 2;
+	uint8_t* dst = textureDataRaw.data();
 
-			uint8_t cR1 = textureData.GetIndexedPixel(y, x);
-			uint8_t cR2 = textureData.GetIndexedPixel(y, x + 1);
+	for (size_t y = 0; y < height; y++)
+	{
+		const uint8_t* src = textureData.GetRow(y);
 
-			textureDataRaw[pos] = (cR1 << 4) | (cR2);
-		}
+		for (size_t texel = y * width; texel < (y + 1) * width; texel++, src++)
+			dst[texel / 2] |= *src << ((~texel & 1) * 4);
 	}
 }
 
 void ZTexture::ConvertBitmapToN64_Palette8()
 {
-	for (uint16_t y = 0; y < height; y++)
-	{
-		for (uint16_t x = 0; x < width; x++)
-		{
-			size_t pos = ((y * width) + x);
-			uint8_t cR = textureData.GetIndexedPixel(y, x);
+	uint8_t* dst = textureDataRaw.data();
 
-			textureDataRaw[pos] = cR;
-		}
+	if (textureData.GetRowStride() == width)
+	{
+		memcpy(dst, textureData.GetImageData(), width * height);
+		return;
 	}
+
+	for (size_t y = 0; y < height; y++, dst += width)
+		memcpy(dst, textureData.GetRow(y), width);
 }
 
 float ZTexture::GetPixelMultiplyer() const
@@ -732,8 +727,10 @@ void ZTexture::Save(const fs::path& outFolder)
 	// process for generating the Texture Pool XML.
 	if (Globals::Instance->outputCrc)
 	{
-		File::WriteAllText((Globals::Instance->outputPath / (outName + ".txt")).string(),
-		                   StringHelper::Sprintf("%08lX", hash));
+		fs::path crcPath = Globals::Instance->outputPath / (outName + ".txt");
+
+		File::WriteAllText(crcPath, StringHelper::Sprintf("%08lX", hash));
+		Globals::Instance->outputFiles.push_back(crcPath);
 	}
 
 	auto outPath = GetPoolOutPath(outFolder);
@@ -748,6 +745,10 @@ void ZTexture::Save(const fs::path& outFolder)
 	else
 		outFileName = outPath / (outName + +"." + GetExternalExtension() + ".png");
 
+	if (Globals::Instance->textureDedupManifestPath != "" &&
+	    !TextureDedupPool::Register(GetDedupContent(), outFileName))
+		return;
+
 #ifdef TEXTURE_DEBUG
 	printf("Saving PNG: %s\n", outFileName.c_str());
 	printf("\t Var name: %s\n", name.c_str());
@@ -755,7 +756,8 @@ void ZTexture::Save(const fs::path& outFolder)
 		printf("\t TLUT name: %s\n", tlut->name.c_str());
 #endif
 
-	textureData.WritePng(outFileName);
+	textureData.WritePng(outFileName, Globals::Instance->pngWriteProfile);
+	Globals::Instance->outputFiles.push_back(outFileName);
 
 #ifdef TEXTURE_DEBUG
 	printf("\n");
@@ -825,18 +827,23 @@ std::string ZTexture::GetBodySourceCode() const
 {
 	std::string sourceOutput;
 	size_t texSizeInc = (dWordAligned) ? 8 : 4;
+
+	// Every 32 bytes take a line of about 100 characters
+	sourceOutput.reserve(textureDataRaw.size() * 4 + 1);
+
 	for (size_t i = 0; i < textureDataRaw.size(); i += texSizeInc)
 	{
 		if (i % 32 == 0)
 			sourceOutput += "    ";
 		if (dWordAligned)
-			sourceOutput +=
-				StringHelper::Sprintf("0x%016llX, ", BitConverter::ToUInt64BE(textureDataRaw, i));
+			StringHelper::AppendFormat(sourceOutput, "0x%016llX, ",
+			                           BitConverter::ToUInt64BE(textureDataRaw, i));
 		else
-			sourceOutput +=
-				StringHelper::Sprintf("0x%08llX, ", BitConverter::ToUInt32BE(textureDataRaw, i));
+			StringHelper::AppendFormat(sourceOutput, "0x%08llX, ",
+			                           BitConverter::ToUInt32BE(textureDataRaw, i));
 		if (i % 32 == 24)
-			sourceOutput += StringHelper::Sprintf(" // 0x%06X \n", rawDataIndex + ((i / 32) * 32));
+			StringHelper::AppendFormat(sourceOutput, " // 0x%06X \n",
+			                           rawDataIndex + ((i / 32) * 32));
 	}
 
 	// Ensure there's always a trailing line feed to prevent dumb warnings.
@@ -879,6 +886,29 @@ void ZTexture::CalcHash()
 	hash = CRC32B(parentRawData.data() + rawDataIndex, GetRawDataSize());
 }
 
+TextureDedupContent ZTexture::GetDedupContent() const
+{
+	const uint8_t* data = parent->GetRawData().data() + rawDataIndex;
+	TextureDedupContent content;
+
+	content.settings = StringHelper::Sprintf("%i %u %u", format, width, height);
+	content.texture = {parent->GetBinaryFilePath(), rawDataIndex,
+	                   ByteSpan(data, GetRawDataSize())};
+
+	// The palette of the PNG
+	if (tlut != nullptr)
+	{
+		const uint8_t* tlutData = tlut->parent->GetRawData().data() + tlut->rawDataIndex;
+
+		content.settings += StringHelper::Sprintf(" %i %i %u %u", splitTlut, tlut->format,
+		                                          tlut->width, tlut->height);
+		content.tlut = {tlut->parent->GetBinaryFilePath(), tlut->rawDataIndex,
+		                ByteSpan(tlutData, tlut->GetRawDataSize())};
+	}
+
+	return content;
+}
+
 std::string ZTexture::GetExternalExtension() const
 {
 	switch (format)
@@ -909,7 +939,7 @@ std::string ZTexture::GetExternalExtension() const
 fs::path ZTexture::GetPoolOutPath(const fs::path& defaultValue)
 {
 	if (Globals::Instance->cfg.texturePool.find(hash) != Globals::Instance->cfg.texturePool.end())
-		return Path::GetDirectoryName(Globals::Instance->cfg.texturePool[hash].path.string());
+		return Path::GetDirectoryName(Globals::Instance->cfg.texturePool.at(hash).path.string());
 
 	return defaultValue;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ImageBackend.h"
+#include "TextureDedupPool.h"
 #include "ZResource.h"
 #include "tinyxml2.h"
 
@@ -76,6 +77,11 @@ public:
 	/// </summary>
 	void CalcHash() override;
 
+	/// <summary>
+	/// Returns everything the PNG of this texture depends on, for use with the deduplication pool.
+	/// </summary>
+	TextureDedupContent GetDedupContent() const;
+
 	void Save(const fs::path& outFolder) override;
 
 	std::string GetHeaderDefines() const;
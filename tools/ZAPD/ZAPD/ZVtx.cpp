@@ -1,5 +1,9 @@
 #include "ZVtx.h"
 
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
 #include "Utils/BitConverter.h"
 #include "Utils/StringHelper.h"
 #include "ZFile.h"
@@ -46,8 +50,55 @@ Declaration* ZVtx::DeclareVar(const std::string& prefix, const std::string& body
 
 std::string ZVtx::GetBodySourceCode() const
 {
-	return StringHelper::Sprintf("VTX(%i, %i, %i, %i, %i, %i, %i, %i, %i)", x, y, z, s, t, r, g, b,
-	                             a);
+	std::string output;
+
+	AppendBodySourceCode(output);
+	return output;
+}
+
+void ZVtx::AppendBodySourceCode(std::string& output) const
+{
+	StringHelper::AppendFormat(output, "VTX(%i, %i, %i, %i, %i, %i, %i, %i, %i)", x, y, z, s, t, r,
+	                           g, b, a);
+}
+
+void ZVtx::AppendArrayBodySourceCode(std::string& output, const uint8_t* data, size_t count)
+{
+	// "\tVTX(" + 9 fields of up to 6 characters each and their separators + "),\n"
+	char line[80];
+
+	output.reserve(output.size() + count * 56);
+
+	for (size_t i = 0; i < count; i++, data += 16)
+	{
+		const int32_t fields[] = {
+			BitConverter::ToInt16BE(data + 0),  BitConverter::ToInt16BE(data + 2),
+			BitConverter::ToInt16BE(data + 4),  BitConverter::ToInt16BE(data + 8),
+			BitConverter::ToInt16BE(data + 10), data[12],
+			data[13],                           data[14],
+			data[15],
+		};
+		char* lineEnd = line;
+
+		std::memcpy(lineEnd, "\tVTX(", 5);
+		lineEnd += 5;
+
+		for (size_t j = 0; j < std::size(fields); j++)
+		{
+			if (j != 0)
+			{
+				std::memcpy(lineEnd, ", ", 2);
+				lineEnd += 2;
+			}
+
+			lineEnd = std::to_chars(lineEnd, line + sizeof(line), fields[j]).ptr;
+		}
+
+		std::memcpy(lineEnd, "),\n", 3);
+		lineEnd += 3;
+
+		output.append(line, lineEnd - line);
+	}
 }
 
 size_t ZVtx::GetRawDataSize() const
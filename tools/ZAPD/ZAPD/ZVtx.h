@@ -21,6 +21,11 @@ public:
 
 	Declaration* DeclareVar(const std::string& prefix, const std::string& bodyStr) override;
 	std::string GetBodySourceCode() const override;
+	void AppendBodySourceCode(std::string& output) const;
+
+	// Appends a `VTX(...),` line for each of the `count` vertices at `data`, without having to
+	// parse a ZVtx for each of them.
+	static void AppendArrayBodySourceCode(std::string& output, const uint8_t* data, size_t count);
 
 	bool IsExternalResource() const override;
 	bool DoesSupportArray() const override;
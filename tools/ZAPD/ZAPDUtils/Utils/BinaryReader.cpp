@@ -1,8 +1,32 @@
 #include "BinaryReader.h"
 #include <cmath>
 #include <stdexcept>
+#include <type_traits>
+#include "BitConverter.h"
 #include "Stream.h"
 
+namespace
+{
+template <typename T>
+void ReadArrayBEInPlace(Stream* stream, T* dest, size_t count)
+{
+	// The big-endian bytes are read straight into `dest`, then each value is swapped in place
+	stream->Read(reinterpret_cast<char*>(dest), count * sizeof(T));
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&dest[i]);
+
+		if constexpr (std::is_same_v<T, float>)
+			dest[i] = BitConverter::ToFloatBE(bytes);
+		else if constexpr (sizeof(T) == 2)
+			dest[i] = BitConverter::ToUInt16BE(bytes);
+		else
+			dest[i] = BitConverter::ToUInt32BE(bytes);
+	}
+}
+}
+
 BinaryReader::BinaryReader(Stream* nStream)
 {
 	stream.reset(nStream);
@@ -145,4 +169,24 @@ std::string BinaryReader::ReadString()
 	} while (c != 0);
 
 	return res;
-}
\ No newline at end of file
+}
+
+void BinaryReader::ReadArrayBE(int16_t* dest, size_t count)
+{
+	ReadArrayBEInPlace(stream.get(), dest, count);
+}
+
+void BinaryReader::ReadArrayBE(uint16_t* dest, size_t count)
+{
+	ReadArrayBEInPlace(stream.get(), dest, count);
+}
+
+void BinaryReader::ReadArrayBE(uint32_t* dest, size_t count)
+{
+	ReadArrayBEInPlace(stream.get(), dest, count);
+}
+
+void BinaryReader::ReadArrayBE(float* dest, size_t count)
+{
+	ReadArrayBEInPlace(stream.get(), dest, count);
+}
@@ -38,6 +38,12 @@ public:
 	Color3b ReadColor3b();
 	std::string ReadString();
 
+	// Read `count` big-endian values at once, with a single read from the stream.
+	void ReadArrayBE(int16_t* dest, size_t count);
+	void ReadArrayBE(uint16_t* dest, size_t count);
+	void ReadArrayBE(uint32_t* dest, size_t count);
+	void ReadArrayBE(float* dest, size_t count);
+
 protected:
 	std::shared_ptr<Stream> stream;
 };
\ No newline at end of file
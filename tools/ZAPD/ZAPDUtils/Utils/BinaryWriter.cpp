@@ -1,5 +1,39 @@
 #include "BinaryWriter.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+template <typename T>
+void WriteArrayBEChunked(Stream* stream, const T* values, size_t count)
+{
+	using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, uint32_t>;
+	static_assert(sizeof(Bits) == sizeof(T), "expected 16-bit or 32-bit values");
+
+	// Converted a chunk at a time, so the stream is only called once per chunk
+	char chunk[1024];
+	constexpr size_t chunkCount = sizeof(chunk) / sizeof(T);
+
+	for (size_t start = 0; start < count; start += chunkCount)
+	{
+		size_t length = std::min(chunkCount, count - start);
+
+		for (size_t i = 0; i < length; i++)
+		{
+			Bits bits;
+			std::memcpy(&bits, &values[start + i], sizeof(bits));
+
+			for (size_t j = 0; j < sizeof(T); j++)
+				chunk[i * sizeof(T) + j] = (bits >> ((sizeof(T) - 1 - j) * 8)) & 0xFF;
+		}
+
+		stream->Write(chunk, length * sizeof(T));
+	}
+}
+}
+
 BinaryWriter::BinaryWriter(Stream* nStream)
 {
 	stream.reset(nStream);
@@ -93,3 +127,23 @@ void BinaryWriter::Write(const std::string& str)
 	for (char c : str)
 		stream->WriteByte(c);
 }
+
+void BinaryWriter::WriteArrayBE(const int16_t* values, size_t count)
+{
+	WriteArrayBEChunked(stream.get(), values, count);
+}
+
+void BinaryWriter::WriteArrayBE(const uint16_t* values, size_t count)
+{
+	WriteArrayBEChunked(stream.get(), values, count);
+}
+
+void BinaryWriter::WriteArrayBE(const uint32_t* values, size_t count)
+{
+	WriteArrayBEChunked(stream.get(), values, count);
+}
+
+void BinaryWriter::WriteArrayBE(const float* values, size_t count)
+{
+	WriteArrayBEChunked(stream.get(), values, count);
+}
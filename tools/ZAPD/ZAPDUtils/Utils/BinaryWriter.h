@@ -30,6 +30,12 @@ public:
 	void Write(double value);
 	void Write(const std::string& str);
 
+	// Write `count` values at once, converted to big-endian, the byte order of the game data.
+	void WriteArrayBE(const int16_t* values, size_t count);
+	void WriteArrayBE(const uint16_t* values, size_t count);
+	void WriteArrayBE(const uint32_t* values, size_t count);
+	void WriteArrayBE(const float* values, size_t count);
+
 protected:
 	std::shared_ptr<Stream> stream;
 };
\ No newline at end of file
@@ -5,7 +5,8 @@
 #include <cstdio>
 #include <cstring>
 #include <limits>
-#include <vector>
+
+#include "ByteSpan.h"
 
 #define ALIGN8(val) (((val) + 7) & ~7)
 #define ALIGN16(val) (((val) + 0xF) & ~0xF)
@@ -18,7 +19,7 @@
 class BitConverter
 {
 public:
-	static inline int8_t ToInt8BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline int8_t ToInt8BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 0 > data.size())
 		{
@@ -30,7 +31,7 @@ public:
 		return (int8_t)data.at(offset + 0);
 	}
 
-	static inline uint8_t ToUInt8BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline uint8_t ToUInt8BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 0 > data.size())
 		{
@@ -42,7 +43,7 @@ public:
 		return (uint8_t)data.at(offset + 0);
 	}
 
-	static inline int16_t ToInt16BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline int16_t ToInt16BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 1 > data.size())
 		{
@@ -54,7 +55,7 @@ public:
 		return ((uint16_t)data.at(offset + 0) << 8) + (uint16_t)data.at(offset + 1);
 	}
 
-	static inline uint16_t ToUInt16BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline uint16_t ToUInt16BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 1 > data.size())
 		{
@@ -66,7 +67,7 @@ public:
 		return ((uint16_t)data.at(offset + 0) << 8) + (uint16_t)data.at(offset + 1);
 	}
 
-	static inline int32_t ToInt32BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline int32_t ToInt32BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 3 > data.size())
 		{
@@ -79,7 +80,7 @@ public:
 		       ((uint32_t)data.at(offset + 2) << 8) + (uint32_t)data.at(offset + 3);
 	}
 
-	static inline uint32_t ToUInt32BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline uint32_t ToUInt32BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 3 > data.size())
 		{
@@ -92,7 +93,7 @@ public:
 		       ((uint32_t)data.at(offset + 2) << 8) + (uint32_t)data.at(offset + 3);
 	}
 
-	static inline int64_t ToInt64BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline int64_t ToInt64BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 7 > data.size())
 		{
@@ -107,7 +108,7 @@ public:
 		       ((uint64_t)data.at(offset + 6) << 8) + ((uint64_t)data.at(offset + 7));
 	}
 
-	static inline uint64_t ToUInt64BE(const std::vector<uint8_t>& data, size_t offset)
+	static inline uint64_t ToUInt64BE(ByteSpan data, size_t offset)
 	{
 		if (offset + 7 > data.size())
 		{
@@ -122,7 +123,7 @@ public:
 		       ((uint64_t)data.at(offset + 6) << 8) + ((uint64_t)data.at(offset + 7));
 	}
 
-	static inline float ToFloatBE(const std::vector<uint8_t>& data, size_t offset)
+	static inline float ToFloatBE(ByteSpan data, size_t offset)
 	{
 		if (offset + 3 > data.size())
 		{
@@ -140,7 +141,7 @@ public:
 		return value;
 	}
 
-	static inline double ToDoubleBE(const std::vector<uint8_t>& data, size_t offset)
+	static inline double ToDoubleBE(ByteSpan data, size_t offset)
 	{
 		if (offset + 7 > data.size())
 		{
@@ -163,4 +164,36 @@ public:
 		std::memcpy(&value, &floatData, sizeof(value));
 		return value;
 	}
+
+	// Unchecked reads, for decoding arrays whose bounds were checked once beforehand.
+
+	static inline int16_t ToInt16BE(const uint8_t* data)
+	{
+		return ((uint16_t)data[0] << 8) + (uint16_t)data[1];
+	}
+
+	static inline uint16_t ToUInt16BE(const uint8_t* data)
+	{
+		return ((uint16_t)data[0] << 8) + (uint16_t)data[1];
+	}
+
+	static inline int32_t ToInt32BE(const uint8_t* data)
+	{
+		return ((uint32_t)data[0] << 24) + ((uint32_t)data[1] << 16) + ((uint32_t)data[2] << 8) +
+		       (uint32_t)data[3];
+	}
+
+	static inline uint32_t ToUInt32BE(const uint8_t* data)
+	{
+		return ((uint32_t)data[0] << 24) + ((uint32_t)data[1] << 16) + ((uint32_t)data[2] << 8) +
+		       (uint32_t)data[3];
+	}
+
+	static inline float ToFloatBE(const uint8_t* data)
+	{
+		float value;
+		uint32_t floatData = ToUInt32BE(data);
+		std::memcpy(&value, &floatData, sizeof(value));
+		return value;
+	}
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Read-only view of a contiguous byte buffer owned by somebody else, like a
+ * `std::span<const uint8_t>`. A vector converts to it implicitly, so the functions taking a
+ * ByteSpan also accept a `std::vector<uint8_t>`.
+ */
+class ByteSpan
+{
+public:
+	ByteSpan() = default;
+
+	ByteSpan(const uint8_t* nData, size_t nSize) : spanData(nData), spanSize(nSize)
+	{
+	}
+
+	ByteSpan(const std::vector<uint8_t>& vector) : spanData(vector.data()), spanSize(vector.size())
+	{
+	}
+
+	const uint8_t* data() const
+	{
+		return spanData;
+	}
+
+	size_t size() const
+	{
+		return spanSize;
+	}
+
+	bool empty() const
+	{
+		return spanSize == 0;
+	}
+
+	const uint8_t* begin() const
+	{
+		return spanData;
+	}
+
+	const uint8_t* end() const
+	{
+		return spanData + spanSize;
+	}
+
+	const uint8_t& operator[](size_t index) const
+	{
+		return spanData[index];
+	}
+
+	// Bounds checked, throws std::out_of_range like `std::vector::at`
+	const uint8_t& at(size_t index) const
+	{
+		if (index >= spanSize)
+			throw std::out_of_range("ByteSpan::at: index out of range");
+
+		return spanData[index];
+	}
+
+protected:
+	const uint8_t* spanData = nullptr;
+	size_t spanSize = 0;
+};
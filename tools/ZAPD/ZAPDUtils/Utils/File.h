@@ -6,6 +6,7 @@
 #include <fstream>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "Directory.h"
@@ -94,4 +95,36 @@ public:
 		file.write(text.c_str(), text.size());
 		file.close();
 	}
+
+	// The *IfChanged variants leave the file untouched (keeping its modification time, so it isn't
+	// rebuilt by make) if it already has the given contents. They return whether it was written.
+	static bool WriteAllBytesIfChanged(const fs::path& filePath, const std::vector<uint8_t>& data)
+	{
+		if (HasContents(filePath, (const char*)data.data(), data.size()))
+			return false;
+
+		WriteAllBytes(filePath, data);
+		return true;
+	}
+
+	static bool WriteAllTextIfChanged(const fs::path& filePath, const std::string& text)
+	{
+		if (HasContents(filePath, text.c_str(), text.size()))
+			return false;
+
+		WriteAllText(filePath, text);
+		return true;
+	}
+
+	static bool HasContents(const fs::path& filePath, const char* data, size_t dataSize)
+	{
+		if (!fs::is_regular_file(filePath) || fs::file_size(filePath) != dataSize)
+			return false;
+
+		std::vector<char> fileData(dataSize);
+		ifstream file(filePath, std::ios::in | std::ios::binary);
+		file.read(fileData.data(), dataSize);
+
+		return file.good() && std::equal(fileData.begin(), fileData.end(), data);
+	}
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ByteSpan.h"
+#include "Directory.h"
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The pages are only read from the disk when they are first accessed, and are shared through the
+ * page cache with every other process mapping or reading the same file, so opening a large file
+ * neither copies it nor reads the parts of it which are never used.
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Maps `filePath`, unmapping the previous file if any. Returns false if the file couldn't be
+	// opened or mapped.
+	bool Open(const fs::path& filePath);
+	void Close();
+
+	ByteSpan GetData() const;
+
+protected:
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+};
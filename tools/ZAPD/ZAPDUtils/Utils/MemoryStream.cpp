@@ -1,4 +1,5 @@
 #include "MemoryStream.h"
+#include <algorithm>
 #include <cstring>
 
 #ifndef _MSC_VER
@@ -25,7 +26,7 @@ MemoryStream::~MemoryStream()
 
 uint64_t MemoryStream::GetLength()
 {
-	return buffer.size();
+	return bufferSize;
 }
 
 void MemoryStream::Seek(int32_t offset, SeekOffsetType seekType)
@@ -61,30 +62,34 @@ int8_t MemoryStream::ReadByte()
 
 void MemoryStream::Write(char* srcBuffer, size_t length)
 {
-	if (baseAddress + length >= buffer.size())
-	{
-		buffer.resize(baseAddress + length);
-		bufferSize += length;
-	}
+	size_t end = baseAddress + length;
 
-	memcpy_s(&buffer[baseAddress], length, srcBuffer, length);
-	baseAddress += length;
+	if (end > buffer.size())
+		Reserve(std::max(end, buffer.size() * 2));
+
+	memcpy_s(buffer.data() + baseAddress, length, srcBuffer, length);
+	baseAddress = end;
+	bufferSize = std::max(bufferSize, end);
 }
 
 void MemoryStream::WriteByte(int8_t value)
 {
 	if (baseAddress >= buffer.size())
-	{
-		buffer.resize(baseAddress + 1);
-		bufferSize = baseAddress;
-	}
+		Reserve(std::max<size_t>(baseAddress + 1, buffer.size() * 2));
 
 	buffer[baseAddress++] = value;
+	bufferSize = std::max<size_t>(bufferSize, baseAddress);
 }
 
 std::vector<char> MemoryStream::ToVector()
 {
-	return buffer;
+	return std::vector<char>(buffer.begin(), buffer.begin() + bufferSize);
+}
+
+void MemoryStream::Reserve(size_t capacity)
+{
+	if (capacity > buffer.size())
+		buffer.resize(capacity);
 }
 
 void MemoryStream::Flush()
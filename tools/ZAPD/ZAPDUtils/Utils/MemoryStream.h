@@ -24,10 +24,16 @@ public:
 
 	std::vector<char> ToVector();
 
+	// Grows the buffer to hold at least `capacity` bytes without reallocating
+	void Reserve(size_t capacity);
+
 	void Flush() override;
 	void Close() override;
 
 protected:
+	// Only the first `bufferSize` bytes are data, the rest is the room left to write without
+	// reallocating. The buffer at least doubles each time it grows, so writing a stream a few
+	// bytes at a time only copies each byte a constant number of times.
 	std::vector<char> buffer;
 	std::size_t bufferSize;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "BitConverter.h"
+#include "ByteSpan.h"
+
+/**
+ * Reads the big-endian values of a ByteSpan one after the other.
+ *
+ * Unlike BinaryReader, nothing goes through a virtual Stream: every read is inlined and checks the
+ * bounds once, so parsing structs field by field or whole arrays costs about as much as decoding
+ * the bytes. Reading past the end throws std::out_of_range, like `ByteSpan::at`.
+ */
+class SpanReader
+{
+public:
+	SpanReader(ByteSpan nData, size_t nOffset = 0) : data(nData), offset(nOffset)
+	{
+	}
+
+	size_t GetOffset() const
+	{
+		return offset;
+	}
+
+	void Seek(size_t nOffset)
+	{
+		offset = nOffset;
+	}
+
+	void Skip(size_t length)
+	{
+		offset += length;
+	}
+
+	size_t GetRemaining() const
+	{
+		return offset < data.size() ? data.size() - offset : 0;
+	}
+
+	uint8_t ReadUInt8()
+	{
+		return *Take(1);
+	}
+
+	int8_t ReadInt8()
+	{
+		return (int8_t)*Take(1);
+	}
+
+	uint16_t ReadUInt16BE()
+	{
+		return BitConverter::ToUInt16BE(Take(2));
+	}
+
+	int16_t ReadInt16BE()
+	{
+		return BitConverter::ToInt16BE(Take(2));
+	}
+
+	uint32_t ReadUInt32BE()
+	{
+		return BitConverter::ToUInt32BE(Take(4));
+	}
+
+	int32_t ReadInt32BE()
+	{
+		return BitConverter::ToInt32BE(Take(4));
+	}
+
+	float ReadFloatBE()
+	{
+		return BitConverter::ToFloatBE(Take(4));
+	}
+
+	// Reads `count` values of type `T` (`int16_t`, `uint16_t`, `int32_t`, `uint32_t` or `float`)
+	template <typename T>
+	void ReadArrayBE(T* dest, size_t count)
+	{
+		const uint8_t* src = Take(CheckedArraySize<T>(count));
+
+		for (size_t i = 0; i < count; i++)
+			dest[i] = Decode<T>(src + i * sizeof(T));
+	}
+
+	// Appends `count` values to `dest`, which is only grown once they are known to be in bounds
+	template <typename T>
+	void ReadArrayBE(std::vector<T>& dest, size_t count)
+	{
+		const uint8_t* src = Take(CheckedArraySize<T>(count));
+		size_t start = dest.size();
+
+		dest.resize(start + count);
+		for (size_t i = 0; i < count; i++)
+			dest[start + i] = Decode<T>(src + i * sizeof(T));
+	}
+
+protected:
+	ByteSpan data;
+	size_t offset;
+
+	const uint8_t* Take(size_t length)
+	{
+		if (length > GetRemaining())
+			throw std::out_of_range("SpanReader: reading past the end of the data");
+
+		const uint8_t* result = data.data() + offset;
+		offset += length;
+		return result;
+	}
+
+	template <typename T>
+	size_t CheckedArraySize(size_t count) const
+	{
+		if (count > GetRemaining() / sizeof(T))
+			throw std::out_of_range("SpanReader: reading past the end of the data");
+
+		return count * sizeof(T);
+	}
+
+	template <typename T>
+	static T Decode(const uint8_t* src)
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return BitConverter::ToFloatBE(src);
+		else if constexpr (sizeof(T) == 2)
+			return BitConverter::ToUInt16BE(src);
+		else
+		{
+			static_assert(std::is_integral_v<T> && sizeof(T) == 4,
+			              "SpanReader reads arrays of 16-bit or 32-bit integers, or floats");
+			return BitConverter::ToUInt32BE(src);
+		}
+	}
+};
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdarg>
+#include <cstdio>
 #include <cstring>
 #include <numeric>
 #include <string>
@@ -86,6 +87,34 @@ public:
 		return output;
 	}
 
+	// Like Sprintf, but formats straight at the end of `output` instead of into a temporary
+	// string. Meant for the loops emitting an element at a time, so they can reuse one buffer.
+	static void AppendFormat(std::string& output, const char* format, ...)
+	{
+		// Most elements fit in this, so they're formatted once and only their length is appended
+		char buffer[256];
+		va_list va;
+		va_list vaRetry;
+
+		va_start(va, format);
+		va_copy(vaRetry, va);
+
+		int len = vsnprintf(buffer, sizeof(buffer), format, va);
+
+		if (len >= 0 && (size_t)len < sizeof(buffer))
+			output.append(buffer, len);
+		else if (len >= 0)
+		{
+			size_t oldSize = output.size();
+
+			output.resize(oldSize + len);
+			vsnprintf(&output[oldSize], len + 1, format, vaRetry);
+		}
+
+		va_end(vaRetry);
+		va_end(va);
+	}
+
 	static std::string Implode(std::vector<std::string>& elements, const char* const separator)
 	{
 		return std::accumulate(std::begin(elements), std::end(elements), std::string(),
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+#
+#   Loads the resources extracted by ZAPD, from the .zres containers written with `-se ZRES` and
+#   from the generated C, and compares how long both take.
+#   Arguments: <output folder> [--root <folder the C includes are relative to>] [--runs N]
+#   Example:
+#     ./ZAPD.out e -i assets/xml/objects/object_link_boy.xml -b baserom/ \
+#       -o assets/objects/object_link_boy -osf assets/objects/object_link_boy -se ZRES
+#     python3 tools/ZAPD/zres_bench.py assets/objects
+#
+
+import argparse, mmap, os, re, struct, sys, time
+
+ZRES_MAGIC = b"ZRES"
+ZRES_VERSION = 1
+HEADER = struct.Struct("<4sHHIIIIII")
+ENTRY = struct.Struct("<IIIIII")
+
+
+class ZResContainer:
+    """A .zres container mapped in memory, see ZAPD/ResourceContainer.h for its layout."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        (magic, version, header_size, self.entry_count, self.entries_offset, self.names_offset,
+         self.names_size, self.segment, size) = HEADER.unpack_from(self.data, 0)
+
+        if magic != ZRES_MAGIC or version != ZRES_VERSION or size != len(self.data):
+            raise ValueError(f"{path}: not a version {ZRES_VERSION} .zres container")
+
+    def name(self, offset):
+        start = self.names_offset + offset
+        return self.data[start:self.data.find(b"\0", start)].decode()
+
+    def resources(self):
+        """Yields the name, C type and data (a view of the mapping, not a copy) of each resource."""
+        view = memoryview(self.data)
+
+        for i in range(self.entry_count):
+            name_offset, type_name_offset, _, _, data_offset, data_size = ENTRY.unpack_from(
+                self.data, self.entries_offset + i * ENTRY.size)
+            yield (self.name(name_offset), self.name(type_name_offset),
+                   view[data_offset:data_offset + data_size])
+
+
+DECLARATION = re.compile(r"^(?:static )?(?:const )?(\w+) (\w+)(?:\[[^\]]*\])* = \{(.*?)^\};",
+                         re.MULTILINE | re.DOTALL)
+INCLUDE = re.compile(r'^#include "([^"]+)"$', re.MULTILINE)
+VALUE = re.compile(r"-?0x[0-9A-Fa-f]+|-?\d+(?:\.\d+)?f?|\w+")
+
+
+def to_value(token):
+    digits = token.lstrip("-")
+
+    if digits.startswith("0x"):
+        return int(token, 16)
+    if digits.isdigit():
+        return int(token)
+    return token
+
+
+def parse_c(path, root):
+    """
+    Yields the name, C type and initializer values of each array of a generated C file, reading
+    the files it includes. This is the least a tool reading the C has to do: the macros (`gsSP...`,
+    `VTX`...) are kept as names instead of being expanded to bytes.
+    """
+    with open(path) as f:
+        source = f.read()
+
+    for var_type, name, body in DECLARATION.findall(source):
+        def read_include(match):
+            include_path = os.path.join(root, match.group(1))
+            # The textures are only converted to C by the build, skip them if it wasn't run
+            if not os.path.exists(include_path):
+                return ""
+            with open(include_path) as f:
+                return f.read()
+
+        body = INCLUDE.sub(read_include, body)
+        yield name, var_type, [to_value(token) for token in VALUE.findall(body)]
+
+
+def find_outputs(folder):
+    for dirpath, _, filenames in os.walk(folder):
+        for filename in sorted(filenames):
+            if filename.endswith(".zres"):
+                c_path = os.path.join(dirpath, filename[:-len(".zres")] + ".c")
+                if os.path.exists(c_path):
+                    yield os.path.join(dirpath, filename), c_path
+
+
+def time_runs(runs, load):
+    best = None
+
+    for _ in range(runs):
+        start = time.perf_counter()
+        count = load()
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+
+    return best, count
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare loading ZAPD .zres containers and generated C")
+    parser.add_argument("folder", help="folder searched for .zres files with a .c next to them")
+    parser.add_argument("--root", default=".",
+                        help="folder the #include paths of the C files are relative to")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="runs of each loader, the fastest is kept")
+    args = parser.parse_args()
+
+    outputs = list(find_outputs(args.folder))
+    if len(outputs) == 0:
+        sys.exit(f"No .zres container with its .c file found in {args.folder}, "
+                 "was ZAPD run with `-se ZRES`?")
+
+    def load_containers():
+        count = 0
+        for zres_path, _ in outputs:
+            count += sum(len(data) > 0 for _, _, data in ZResContainer(zres_path).resources())
+        return count
+
+    def load_c():
+        count = 0
+        for _, c_path in outputs:
+            count += sum(len(values) > 0 for _, _, values in parse_c(c_path, args.root))
+        return count
+
+    zres_time, zres_count = time_runs(args.runs, load_containers)
+    c_time, c_count = time_runs(args.runs, load_c)
+
+    print(f"{len(outputs)} files")
+    print(f".zres: {zres_count} resources in {zres_time * 1000:.3f} ms")
+    print(f"C:     {c_count} arrays in {c_time * 1000:.3f} ms "
+          f"({c_time / zres_time:.1f}x slower)")
+
+
+if __name__ == "__main__":
+    main()
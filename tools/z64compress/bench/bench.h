@@ -0,0 +1,47 @@
+/* 
+ * bench.h
+ * 
+ * helpers shared by the microbenchmarks
+ * 
+ */
+
+#ifndef Z64COMPRESS_BENCH_H_INCLUDED
+#define Z64COMPRESS_BENCH_H_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* monotonic time in seconds */
+static double now(void)
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* read a whole file into a new buffer; returns 0 if it can't be read */
+static void *load(const char *fn, unsigned *sz)
+{
+	FILE *fp = fopen(fn, "rb");
+	void *buf;
+	
+	if (!fp)
+		return 0;
+	
+	fseek(fp, 0, SEEK_END);
+	*sz = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	buf = malloc(*sz + 1);
+	if (fread(buf, 1, *sz, fp) != *sz)
+	{
+		free(buf);
+		buf = 0;
+	}
+	fclose(fp);
+	
+	return buf;
+}
+
+#endif /* Z64COMPRESS_BENCH_H_INCLUDED */
@@ -0,0 +1,115 @@
+/* 
+ * hashbench.c
+ * 
+ * microbenchmark of the hashes the compression cache can make its keys
+ * with: hashes every file given on the command line (e.g. a whole
+ * uncompressed rom, or the dmadata files of a baserom folder) with each
+ * of them, keeps the fastest of a few runs, and prints the time it took
+ * 
+ * make hashbench && ./hashbench path/to/uncompressed.z64
+ * 
+ */
+
+#include <string.h>
+
+#include "bench.h"
+#include "../src/sha1.c"
+#include "../src/murmur3.c"
+
+#define RUNS 5
+
+struct file
+{
+	unsigned char *data;
+	unsigned sz;
+};
+
+/* keeps the compiler from removing the work */
+static volatile unsigned char sink;
+
+static void hash_sha1(unsigned char *data, unsigned sz)
+{
+	unsigned char out[20];
+	
+	stb_sha1(out, data, sz);
+	sink ^= out[0];
+}
+
+static void hash_murmur3(unsigned char *data, unsigned sz)
+{
+	unsigned char out[16];
+	
+	murmur3_128(data, sz, 0, out);
+	sink ^= out[0];
+}
+
+/* fastest of RUNS passes over every file, in seconds */
+static double bench(
+	struct file *files
+	, int num
+	, void hash(unsigned char *data, unsigned sz)
+)
+{
+	double best = 0;
+	int run, i;
+	
+	for (run = 0; run < RUNS; ++run)
+	{
+		double start = now();
+		
+		for (i = 0; i < num; ++i)
+			hash(files[i].data, files[i].sz);
+		
+		start = now() - start;
+		if (!run || start < best)
+			best = start;
+	}
+	
+	return best;
+}
+
+int main(int argc, char *argv[])
+{
+	struct file *files;
+	unsigned long long total = 0;
+	double sha1Time, murmur3Time;
+	int i, num = 0;
+	
+	if (argc < 2)
+	{
+		fprintf(stderr, "args: hashbench file [file ...]\n");
+		return EXIT_FAILURE;
+	}
+	
+	files = calloc(argc - 1, sizeof(*files));
+	for (i = 1; i < argc; ++i)
+	{
+		struct file *f = files + num;
+		
+		if (!(f->data = load(argv[i], &f->sz)))
+		{
+			fprintf(stderr, "failed to read '%s'\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		
+		total += f->sz;
+		++num;
+	}
+	
+	sha1Time = bench(files, num, hash_sha1);
+	murmur3Time = bench(files, num, hash_murmur3);
+	
+	printf("%d files, %llu bytes, fastest of %d runs\n", num, total, RUNS);
+	printf("  sha1      %8.3f s %8.1f MB/s\n", sha1Time, total / sha1Time / 1e6);
+	printf("  murmur3   %8.3f s %8.1f MB/s (%.1fx faster)\n"
+		, murmur3Time
+		, total / murmur3Time / 1e6
+		, sha1Time / murmur3Time
+	);
+	
+	for (i = 0; i < num; ++i)
+		free(files[i].data);
+	free(files);
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/* 
+ * yazbench.c
+ * 
+ * microbenchmark of the yaz encoder: compresses every file given on the
+ * command line (e.g. the dmadata files of a baserom folder) with the hash
+ * chain match finder and with the original brute force one, checks that
+ * both produce the same bytes and that they decompress, and prints the
+ * time each took
+ * 
+ * make yazbench && ./yazbench $(find baserom -type f)
+ * 
+ */
+
+#include "bench.h"
+#include "../src/enc/yaz.c"
+
+/* the match finder yaz.c used before the hash chains, scanning the whole
+ * window for each position
+ */
+static int _enc_find(struct yazCtx *ctx, uint8_t *array, uint8_t *needle, int needle_len, int start_index, int source_length) {
+	while(start_index < (source_length - needle_len + 1)) {
+		int r, index = -1;
+		for(r=start_index; r < (source_length - needle_len + 1); r++) {
+			if(array[r]==needle[0]) {
+				index=r;
+				break;
+			}
+		}
+		
+		// if we did not find even the first element, the search has failed
+		if (index == -1)
+			return -1;
+		
+		int i, p;
+		// check for needle
+		for (i = 0, p = index; i < needle_len; i++, p++) {
+			if (array[p] != needle[i])
+				break;
+		}
+		if(i==needle_len) {
+			// needle was found
+			return index;
+		}
+		// continue to search for needle
+		start_index = index + 1;
+	}
+	return -1;
+}
+
+static int *_enc_search_brute(struct yazCtx *ctx, uint8_t *data, uint32_t pos, uint32_t sz, uint32_t cap/*=0x111*/) {
+	int *return_data = ctx->return_data;
+	// this is necessary unless pos is signed, so let's play it safe
+	int mp = (pos>0x1000)?(pos-0x1000):0;
+	int ml = min(cap, sz - pos);
+	if(ml<3) {
+		return_data[0]=return_data[1]=0;
+		return return_data;
+	}
+	int
+		hitp = 0,
+		hitl = 3,
+		hl = -1
+	;
+	
+	if (mp < pos) {
+		hl = _enc_find(ctx, data+mp, data+pos, hitl, 0, pos + hitl - mp);
+		while (hl < (pos - mp)) {
+			while ((hitl < ml) && (data[pos + hitl] == data[mp + hl + hitl]) ) {
+				hitl += 1;
+			}
+			mp += hl;
+			hitp = mp;
+			if (hitl == ml) {
+				return_data[0] = hitp;
+				return_data[1] = hitl;
+				return return_data;
+			}
+			mp += 1;
+			hitl += 1;
+			if (mp >= pos)
+				break;
+			hl = _enc_find(ctx, data+mp, data+pos, hitl, 0, pos + hitl - mp);
+		}
+	}
+	
+	// if length < 4, return miss
+	if (hitl < 4)
+		hitl = 1;
+	
+	return_data[0] = hitp;
+	return_data[1] = hitl-1;
+	return return_data;
+}
+
+int main(int argc, char *argv[])
+{
+	struct yazCtx *ctx = yazCtx_new();
+	double hashTime = 0, bruteTime = 0;
+	unsigned long long total = 0, totalComp = 0;
+	int i, errors = 0;
+	
+	if (argc < 2)
+	{
+		fprintf(stderr, "args: yazbench file [file ...]\n");
+		return EXIT_FAILURE;
+	}
+	
+	for (i = 1; i < argc; ++i)
+	{
+		unsigned sz, hashSz, bruteSz;
+		unsigned char *src = load(argv[i], &sz);
+		unsigned char *hashOut, *bruteOut, *dec;
+		double start;
+		
+		if (!src)
+		{
+			fprintf(stderr, "failed to read '%s'\n", argv[i]);
+			++errors;
+			continue;
+		}
+		
+		hashOut = malloc((sz + 64) * 2);
+		bruteOut = malloc((sz + 64) * 2);
+		dec = malloc(sz + 1);
+		
+		ctx->search = _enc_search;
+		start = now();
+		yazenc(src, sz, hashOut, &hashSz, ctx);
+		hashTime += now() - start;
+		
+		ctx->search = _enc_search_brute;
+		start = now();
+		yazenc(src, sz, bruteOut, &bruteSz, ctx);
+		bruteTime += now() - start;
+		
+		if (hashSz != bruteSz || memcmp(hashOut, bruteOut, hashSz))
+		{
+			fprintf(stderr, "'%s': the match finders disagree\n", argv[i]);
+			++errors;
+		}
+		
+		yazdec(hashOut, dec, sz, 0);
+		if (memcmp(dec, src, sz))
+		{
+			fprintf(stderr, "'%s': doesn't decompress to the input\n", argv[i]);
+			++errors;
+		}
+		
+		total += sz;
+		totalComp += hashSz;
+		free(src);
+		free(hashOut);
+		free(bruteOut);
+		free(dec);
+	}
+	
+	printf("%d files, %llu bytes compressed to %llu\n", argc - 1, total, totalComp);
+	printf("  hash chains   %8.3f s\n", hashTime);
+	printf("  brute force   %8.3f s (%.1fx the hash chains)\n", bruteTime, bruteTime / hashTime);
+	
+	yazCtx_free(ctx);
+	free(ctx);
+	
+	return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,643 @@
+/* 
+ * cache.c
+ * 
+ * index of the files in a compression cache folder, so cached files are
+ * found without listing the folder, and the least recently used ones
+ * are evicted once the folder grows too large
+ * 
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+/* POSIX dependencies */
+#include <dirent.h>
+
+#include "cache.h"
+#include "sha1.h"     /* sha1 helpers */
+#include "murmur3.h"  /* murmur3_128() */
+
+#include "wow.h"
+#include "wow_dirent.h" /* XXX always #include after dirent.h */
+#undef   fopen
+#undef   fread
+#undef   fwrite
+#undef   remove
+#define  fopen   wow_fopen
+#define  fread   wow_fread
+#define  fwrite  wow_fwrite
+#define  remove  wow_remove
+
+/* the index file, in the cache folder of each codec; every value is
+ * little-endian, and it is made of a header:
+ *   0x00  magic "ZCIX"
+ *   0x04  u16 version
+ *   0x06  u8 hash the keys are made with, its index in hashes[]
+ *   0x07  u8 key length
+ *   0x08  u32 run, incremented each time the cache is opened
+ *   0x0C  u32 number of entries
+ * followed by the entries, INDEX_ENTRY_SZ bytes each:
+ *   0x00  key, not terminated
+ *   +0    u8 non-zero if the file is stored uncompressed, as '.raw'
+ *   +1    padding to a multiple of 4 bytes
+ *   -8    u32 file size
+ *   -4    u32 run the file was last used by
+ * an index of another version, hash or key length is rebuilt from the
+ * folder (version 1 had a u16 key length instead of the hash)
+ */
+#define INDEX_NAME      "z64compress.idx"
+#define INDEX_MAGIC     "ZCIX"
+#define INDEX_VERSION   2
+#define INDEX_HEADER_SZ 16
+#define INDEX_ENTRY_SZ(KEY_LEN) ((((KEY_LEN) + 1 + 3) & ~3) + 8)
+
+/*
+ *
+ * private types
+ *
+ */
+
+
+struct cacheHash
+{
+	const char       *name;      /* name given to --cache-hash */
+	int               keyLen;    /* length of its keys         */
+	void            (*key)(const void *data, unsigned sz, char *key);
+};
+
+
+struct cacheEntry
+{
+	char              key[CACHE_KEY_MAX + 1];
+	bool              raw;       /* stored uncompressed        */
+	bool              evicted;   /* file removed from folder   */
+	unsigned int      sz;        /* size of the cached file    */
+	unsigned int      used;      /* run it was last used by    */
+};
+
+
+struct cache
+{
+	char             *codec;     /* extension of compressed files */
+	const struct cacheHash *hash; /* hash the keys are made with  */
+	int               keyLen;    /* hash->keyLen                  */
+	struct cacheEntry *entry;    /* entry array                   */
+	unsigned int      num;       /* number of entries in array    */
+	unsigned int      max;       /* allocated entries             */
+	int              *slot;      /* hash table of entry indices   */
+	unsigned int      slotNum;   /* power of 2, or 0              */
+	unsigned int      run;       /* this run                      */
+};
+
+/*
+ *
+ * private functions
+ *
+ */
+
+
+/* the original keys: the first 156 bits of the sha1,
+ * in stb_sha1_readable()'s base 64
+ */
+static void key_sha1(const void *data, unsigned sz, char *key)
+{
+	unsigned char checksum[20];
+	char readable[30];
+	
+	stb_sha1(checksum, (unsigned char*)data, sz);
+	stb_sha1_readable(readable, checksum);
+	
+	memcpy(key, readable, 26);
+	key[26] = '\0';
+}
+
+
+/* murmur3 in hexadecimal, many times faster than sha1 */
+static void key_murmur3(const void *data, unsigned sz, char *key)
+{
+	unsigned char checksum[16];
+	int i;
+	
+	murmur3_128(data, sz, 0, checksum);
+	
+	for (i = 0; i < 16; ++i)
+		sprintf(key + i * 2, "%02x", checksum[i]);
+}
+
+
+/* the first one is the default; their order is stored in the
+ * index, so new hashes go at the end
+ */
+static const struct cacheHash hashes[] = {
+	{ "murmur3", 32, key_murmur3 },
+	{ "sha1",    26, key_sha1 },
+};
+
+
+static const struct cacheHash *find_hash(const char *name)
+{
+	unsigned int i;
+	
+	if (!name)
+		return hashes;
+	
+	for (i = 0; i < sizeof(hashes) / sizeof(*hashes); ++i)
+		if (!strcmp(hashes[i].name, name))
+			return hashes + i;
+	
+	return 0;
+}
+
+
+static unsigned int get16le(const unsigned char *data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+
+static unsigned int get32le(const unsigned char *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+}
+
+
+static void put16le(unsigned char *data, unsigned int v)
+{
+	data[0] = v;
+	data[1] = v >> 8;
+}
+
+
+static void put32le(unsigned char *data, unsigned int v)
+{
+	data[0] = v;
+	data[1] = v >> 8;
+	data[2] = v >> 16;
+	data[3] = v >> 24;
+}
+
+
+/* FNV-1a */
+static unsigned int key_hash(struct cache *cache, const char *key)
+{
+	unsigned int h = 2166136261u;
+	int i;
+	
+	for (i = 0; i < cache->keyLen; ++i)
+		h = (h ^ (unsigned char)key[i]) * 16777619u;
+	
+	return h;
+}
+
+
+/* slot of key, or of the empty slot where it would go */
+static int *cache_slot(struct cache *cache, const char *key)
+{
+	unsigned int i = key_hash(cache, key) & (cache->slotNum - 1);
+	
+	while (cache->slot[i] >= 0
+		&& memcmp(cache->entry[cache->slot[i]].key, key, cache->keyLen)
+	)
+		i = (i + 1) & (cache->slotNum - 1);
+	
+	return cache->slot + i;
+}
+
+
+/* entry of key, or 0 if there is none */
+static struct cacheEntry *cache_get(struct cache *cache, const char *key)
+{
+	int *slot;
+	
+	if (!cache->slotNum)
+		return 0;
+	
+	slot = cache_slot(cache, key);
+	if (*slot < 0)
+		return 0;
+	
+	return cache->entry + *slot;
+}
+
+
+/* entry of key, added if there is none */
+static struct cacheEntry *cache_add(struct cache *cache, const char *key)
+{
+	struct cacheEntry *entry;
+	int *slot;
+	unsigned int i;
+	
+	if ((entry = cache_get(cache, key)))
+		return entry;
+	
+	/* keep the table at most half full */
+	if ((cache->num + 1) * 2 > cache->slotNum)
+	{
+		free(cache->slot);
+		cache->slotNum = cache->slotNum ? cache->slotNum * 2 : 1024;
+		cache->slot = malloc_safe(cache->slotNum * sizeof(*cache->slot));
+		memset(cache->slot, -1, cache->slotNum * sizeof(*cache->slot));
+		for (i = 0; i < cache->num; ++i)
+			*cache_slot(cache, cache->entry[i].key) = i;
+	}
+	
+	if (cache->num == cache->max)
+	{
+		cache->max = cache->max ? cache->max * 2 : 1024;
+		cache->entry = realloc_safe(
+			cache->entry
+			, cache->max * sizeof(*cache->entry)
+		);
+	}
+	
+	slot = cache_slot(cache, key);
+	*slot = cache->num;
+	
+	entry = cache->entry + cache->num++;
+	memset(entry, 0, sizeof(*entry));
+	memcpy(entry->key, key, cache->keyLen);
+	
+	return entry;
+}
+
+
+/* get the key of a cached file name and whether it is uncompressed;
+ * returns false if it isn't the name of a cached file
+ */
+static bool cache_parse_name(
+	struct cache *cache
+	, const char *name
+	, char key[CACHE_KEY_MAX + 1]
+	, bool *raw
+)
+{
+	const char *ext = name + cache->keyLen;
+	
+	if (strlen(name) <= (size_t)cache->keyLen || *ext != '.')
+		return false;
+	
+	if (!strcmp(ext + 1, "raw"))
+		*raw = true;
+	else if (!strcmp(ext + 1, cache->codec))
+		*raw = false;
+	else
+		return false;
+	
+	memcpy(key, name, cache->keyLen);
+	key[cache->keyLen] = '\0';
+	
+	return true;
+}
+
+
+static void cache_name(
+	struct cache *cache
+	, struct cacheEntry *entry
+	, char name[CACHE_NAME_SZ]
+)
+{
+	snprintf(
+		name
+		, CACHE_NAME_SZ
+		, "%s.%s"
+		, entry->key
+		, entry->raw ? "raw" : cache->codec
+	);
+}
+
+
+/* get size of a file; returns 0 if fopen fails */
+static unsigned int file_size(const char *fn)
+{
+	FILE *fp;
+	unsigned int sz;
+	
+	fp = fopen(fn, "rb");
+	if (!fp)
+		return 0;
+	
+	fseek(fp, 0, SEEK_END);
+	sz = ftell(fp);
+	fclose(fp);
+	
+	return sz;
+}
+
+
+/* returns true if data is an index this version can read */
+static bool index_valid(
+	struct cache *cache
+	, const unsigned char *data
+	, unsigned int sz
+)
+{
+	unsigned int entry_sz = INDEX_ENTRY_SZ(cache->keyLen);
+	
+	if (sz < INDEX_HEADER_SZ)
+		return false;
+	
+	return !memcmp(data, INDEX_MAGIC, 4)
+		&& get16le(data + 0x04) == INDEX_VERSION
+		&& data[0x06] == cache->hash - hashes
+		&& data[0x07] == cache->keyLen
+		&& (sz - INDEX_HEADER_SZ) % entry_sz == 0
+		&& (sz - INDEX_HEADER_SZ) / entry_sz == get32le(data + 0x0C)
+	;
+}
+
+
+/* load the index file; returns false if it is missing or unreadable */
+static bool cache_load(struct cache *cache)
+{
+	FILE *fp;
+	unsigned char *data;
+	unsigned int entry_sz = INDEX_ENTRY_SZ(cache->keyLen);
+	unsigned int sz;
+	unsigned int num;
+	unsigned int i;
+	
+	fp = fopen(INDEX_NAME, "rb");
+	if (!fp)
+		return false;
+	
+	fseek(fp, 0, SEEK_END);
+	sz = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	
+	data = malloc_safe(sz + 1);
+	if (fread(data, 1, sz, fp) != sz || !index_valid(cache, data, sz))
+	{
+		free(data);
+		fclose(fp);
+		return false;
+	}
+	fclose(fp);
+	
+	cache->run = get32le(data + 0x08);
+	num = get32le(data + 0x0C);
+	for (i = 0; i < num; ++i)
+	{
+		unsigned char *src = data + INDEX_HEADER_SZ + i * entry_sz;
+		struct cacheEntry *entry = cache_add(cache, (char*)src);
+		
+		entry->raw = src[cache->keyLen] != 0;
+		entry->sz = get32le(src + entry_sz - 8);
+		entry->used = get32le(src + entry_sz - 4);
+	}
+	free(data);
+	
+	return true;
+}
+
+
+/* rebuild the index from the contents of the folder */
+static void cache_scan(struct cache *cache)
+{
+	wow_DIR *dir;
+	struct wow_dirent *ep;
+	char cwd[4096];
+	
+	/* get current working directory for error reporting */
+	wow_getcwd_safe(cwd, sizeof(cwd));
+	
+	dir = wow_opendir(".");
+	if (!dir)
+		die("failed to parse directory '%s'", cwd);
+	while ((ep = wow_readdir(dir)))
+	{
+		const char *dn = (const char*)ep->d_name;
+		char key[CACHE_KEY_MAX + 1];
+		bool raw;
+		struct cacheEntry *entry;
+	
+		if (!cache_parse_name(cache, dn, key, &raw))
+			continue;
+	
+		/* the index holds a single file per key */
+		if (cache_get(cache, key))
+			continue;
+	
+		/* never used, so first to be evicted */
+		entry = cache_add(cache, key);
+		entry->raw = raw;
+		entry->sz = file_size(dn);
+	}
+	wow_closedir(dir);
+}
+
+
+/* write the index file */
+static void cache_save(struct cache *cache)
+{
+	unsigned char *data;
+	unsigned char *dst;
+	unsigned int entry_sz = INDEX_ENTRY_SZ(cache->keyLen);
+	unsigned int num = 0;
+	unsigned int sz;
+	unsigned int i;
+	FILE *fp;
+	
+	data = calloc_safe(1, INDEX_HEADER_SZ + cache->num * entry_sz);
+	dst = data + INDEX_HEADER_SZ;
+	for (i = 0; i < cache->num; ++i)
+	{
+		struct cacheEntry *entry = cache->entry + i;
+	
+		if (entry->evicted)
+			continue;
+	
+		memcpy(dst, entry->key, cache->keyLen);
+		dst[cache->keyLen] = entry->raw;
+		put32le(dst + entry_sz - 8, entry->sz);
+		put32le(dst + entry_sz - 4, entry->used);
+		dst += entry_sz;
+		num += 1;
+	}
+	
+	memcpy(data, INDEX_MAGIC, 4);
+	put16le(data + 0x04, INDEX_VERSION);
+	data[0x06] = cache->hash - hashes;
+	data[0x07] = cache->keyLen;
+	put32le(data + 0x08, cache->run);
+	put32le(data + 0x0C, num);
+	sz = dst - data;
+	
+	fp = fopen(INDEX_NAME, "wb");
+	if (!fp || fwrite(data, 1, sz, fp) != sz)
+		die("error writing cache index '%s'", INDEX_NAME);
+	fclose(fp);
+	
+	free(data);
+}
+
+
+static int sortfunc_entry_used_ascend(const void *_a, const void *_b)
+{
+	const struct cacheEntry *a = *(const struct cacheEntry**)_a;
+	const struct cacheEntry *b = *(const struct cacheEntry**)_b;
+	
+	if (a->used != b->used)
+		return a->used < b->used ? -1 : 1;
+	
+	return strcmp(a->key, b->key);
+}
+
+/*
+ *
+ * public functions
+ *
+ */
+
+
+bool cache_folder(
+	char dst[CACHE_NAME_SZ]
+	, const char *codec
+	, const char *hash
+)
+{
+	const struct cacheHash *h = find_hash(hash);
+	
+	assert(codec);
+	
+	if (!h)
+		return false;
+	
+	/* sha1 keeps the folder it always had */
+	if (!strcmp(h->name, "sha1"))
+		snprintf(dst, CACHE_NAME_SZ, "%s", codec);
+	else
+		snprintf(dst, CACHE_NAME_SZ, "%s-%s", codec, h->name);
+	
+	return true;
+}
+
+
+struct cache *cache_open(const char *codec, const char *hash)
+{
+	struct cache *cache;
+	
+	assert(codec);
+	
+	cache = calloc_safe(1, sizeof(*cache));
+	cache->codec = strdup_safe(codec);
+	cache->hash = find_hash(hash);
+	if (!cache->hash)
+		die("unknown cache hash '%s'", hash);
+	cache->keyLen = cache->hash->keyLen;
+	
+	if (!cache_load(cache))
+		cache_scan(cache);
+	
+	cache->run += 1;
+	
+	return cache;
+}
+
+
+void cache_key(
+	struct cache *cache
+	, const void *data
+	, unsigned sz
+	, unsigned split
+	, char key[CACHE_KEY_MAX + 1]
+)
+{
+	assert(cache);
+	
+	cache->hash->key(data, sz, key);
+	
+	/* a file compressed in blocks isn't the file compressed as a whole,
+	 * so it gets the key of its key and block size instead
+	 */
+	if (split)
+	{
+		char split_key[CACHE_KEY_MAX + 16];
+		
+		snprintf(split_key, sizeof(split_key), "%s-s%u", key, split / 1024);
+		cache->hash->key(split_key, strlen(split_key), key);
+	}
+}
+
+
+bool cache_find(struct cache *cache, const char *key, char name[CACHE_NAME_SZ])
+{
+	struct cacheEntry *entry;
+	
+	assert(cache);
+	assert(key);
+	
+	if (!(entry = cache_get(cache, key)))
+		return false;
+	
+	cache_name(cache, entry, name);
+	
+	return true;
+}
+
+
+void cache_use(struct cache *cache, const char *name, unsigned sz)
+{
+	struct cacheEntry *entry;
+	char key[CACHE_KEY_MAX + 1];
+	bool raw;
+	
+	assert(cache);
+	assert(name);
+	
+	if (!cache_parse_name(cache, name, key, &raw))
+		die("'%s' is not the name of a cached file", name);
+	
+	entry = cache_add(cache, key);
+	entry->raw = raw;
+	entry->sz = sz;
+	entry->used = cache->run;
+}
+
+
+void cache_close(struct cache *cache, unsigned long long max_sz)
+{
+	struct cacheEntry **unused;
+	unsigned long long total = 0;
+	unsigned int num = 0;
+	unsigned int i;
+	
+	if (!cache)
+		return;
+	
+	/* the files this run didn't use, least recently used first */
+	unused = calloc_safe(cache->num + 1, sizeof(*unused));
+	for (i = 0; i < cache->num; ++i)
+	{
+		struct cacheEntry *entry = cache->entry + i;
+	
+		total += entry->sz;
+		if (entry->used != cache->run)
+			unused[num++] = entry;
+	}
+	qsort(unused, num, sizeof(*unused), sortfunc_entry_used_ascend);
+	
+	for (i = 0; i < num && total > max_sz; ++i)
+	{
+		char name[CACHE_NAME_SZ];
+	
+		cache_name(cache, unused[i], name);
+	
+		/* fine if it was already removed by hand */
+		if (remove(name) && file_size(name))
+			die("failed to remove cached file '%s'", name);
+	
+		unused[i]->evicted = true;
+		total -= unused[i]->sz;
+	}
+	free(unused);
+	
+	cache_save(cache);
+	
+	free(cache->codec);
+	free(cache->entry);
+	free(cache->slot);
+	free(cache);
+}
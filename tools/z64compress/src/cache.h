@@ -0,0 +1,61 @@
+/* 
+ * cache.h
+ * 
+ * index of the files in a compression cache folder
+ * 
+ */
+
+#ifndef Z64COMPRESS_CACHE_H_INCLUDED
+#define Z64COMPRESS_CACHE_H_INCLUDED
+
+#include <stdbool.h>
+
+/* longest key, the name of a cached file without its extension */
+#define CACHE_KEY_MAX 32
+
+/* big enough for the name of any cached file, extension included */
+#define CACHE_NAME_SZ 64
+
+/* opaque definition */
+struct cache;
+
+/* get the name of the folder, in the cache directory, of the files of
+ * codec whose keys are made with hash ("murmur3" or "sha1", 0 for the
+ * default); returns false if hash is unknown
+ */
+bool cache_folder(char dst[CACHE_NAME_SZ], const char *codec, const char *hash);
+
+/* open the index of the cache folder of codec and hash, which must be the
+ * current working directory; if the index file is missing or unreadable,
+ * it is rebuilt from the contents of the folder
+ */
+struct cache *cache_open(const char *codec, const char *hash);
+
+/* get the key of the uncompressed data of a file, which is compressed in
+ * blocks of split bytes (0 if it isn't split)
+ */
+void cache_key(
+	struct cache *cache
+	, const void *data
+	, unsigned sz
+	, unsigned split
+	, char key[CACHE_KEY_MAX + 1]
+);
+
+/* if the file of key is cached, write its name to name and return true
+ * NOTE: can be called by several threads at once, but not with cache_use()
+ */
+bool cache_find(struct cache *cache, const char *key, char name[CACHE_NAME_SZ]);
+
+/* mark the cached file name, of sz bytes, as used by this run,
+ * adding it to the index if it is new
+ */
+void cache_use(struct cache *cache, const char *name, unsigned sz);
+
+/* remove the least recently used files, except those used by this run,
+ * until the cached files take at most max_sz bytes, then write the index
+ * and free the cache
+ */
+void cache_close(struct cache *cache, unsigned long long max_sz);
+
+#endif /* Z64COMPRESS_CACHE_H_INCLUDED */
@@ -8,6 +8,23 @@ int yazenc(
 	, unsigned *dst_sz
 	, void *_ctx
 );
+/* compresses src[start, end) as a Yaz0 stream whose back references can
+ * reach before start, so it's only valid once joined with the blocks
+ * before it (in a single Yaz0 stream) by yazjoin
+ */
+int yazenc_block(
+	void *src
+	, unsigned start
+	, unsigned end
+	, void *dst
+	, unsigned *dst_sz
+	, void *_ctx
+);
+/* joins num consecutive blocks made by yazenc_block, blocks[i] holding
+ * dec_szs[i] bytes of decompressed data, into one Yaz0 stream of
+ * dst_dec_sz bytes; returns its size, at most 16 + the size of the blocks
+ */
+unsigned yazjoin(void *dst, unsigned dst_dec_sz, void **blocks, unsigned *dec_szs, int num);
 void *yazCtx_new(void);
 void yazCtx_free(void *_ctx);
 int yazdec(void *_src, void *_dst, unsigned dstSz, unsigned *srcSz);
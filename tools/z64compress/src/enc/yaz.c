@@ -4,6 +4,14 @@
 #include <string.h>
 #include "stretchy_buffer.h"
 
+/* the match finder keeps, for every 3-byte string of the window, a chain
+ * of the positions it was seen at (oldest first), so a search only visits
+ * the positions that can match instead of the whole window
+ */
+#define YAZ_WINDOW     0x1000
+#define YAZ_HASH_BITS  14
+#define YAZ_NIL        -1
+
 struct yazCtx
 {
 	uint16_t  *c;
@@ -13,8 +21,19 @@ struct yazCtx
 	uint8_t   *ctl;
 	uint8_t   *back;
 	int       *return_data;
+	int32_t   *head;     /* latest position of each hash, or YAZ_NIL */
+	int32_t   *tail;     /* oldest position of each hash, or YAZ_NIL */
+	int32_t   *next;     /* next position with the same hash, or YAZ_NIL,
+	                      * indexed by position % YAZ_WINDOW */
+	uint32_t   first;    /* first chained position */
+	uint32_t   inserted; /* positions below this one are chained */
+	
+	/* finds the longest match for pos, see _enc_search */
+	int *(*search)(struct yazCtx *ctx, uint8_t *data, uint32_t pos, uint32_t sz, uint32_t cap);
 };
 
+static int *_enc_search(struct yazCtx *ctx, uint8_t *data, uint32_t pos, uint32_t sz, uint32_t cap);
+
 void yazCtx_free(void *_ctx)
 {
 	struct yazCtx *ctx = _ctx;
@@ -23,6 +42,9 @@ void yazCtx_free(void *_ctx)
 		return;
 	
 	free(ctx->return_data);
+	free(ctx->head);
+	free(ctx->tail);
+	free(ctx->next);
 	sb_free(ctx->c);
 	sb_free(ctx->raws);
 	sb_free(ctx->ctrl);
@@ -46,6 +68,10 @@ void *yazCtx_new(void)
 	ctx->cmds = sb_add(ctx->cmds, 32);
 	ctx->ctl  = sb_add(ctx->ctl , 32);
 	ctx->back = sb_add(ctx->back, 32);
+	ctx->head = malloc((1 << YAZ_HASH_BITS) * sizeof(*ctx->head));
+	ctx->tail = malloc((1 << YAZ_HASH_BITS) * sizeof(*ctx->tail));
+	ctx->next = malloc(YAZ_WINDOW * sizeof(*ctx->next));
+	ctx->search = _enc_search;
 	
 	return ctx;
 }
@@ -117,89 +143,96 @@ static uint32_t _enc_z_from_tables(struct yazCtx *ctx, uint8_t *ctl, uint8_t *ba
 	return output_position;
 }
 
-static int _enc_find(struct yazCtx *ctx, uint8_t *array, uint8_t *needle, int needle_len, int start_index, int source_length) {
-	while(start_index < (source_length - needle_len + 1)) {
-		int r, index = -1;
-		for(r=start_index; r < (source_length - needle_len + 1); r++) {
-			if(array[r]==needle[0]) {
-				index=r;
-				break;
-			}
-		}
-		
-		// if we did not find even the first element, the search has failed
-		if (index == -1)
-			return -1;
+static inline uint32_t _enc_hash(uint8_t *p) {
+	uint32_t v = (p[0] << 16) | (p[1] << 8) | p[2];
+	return (v * 2654435761u) >> (32 - YAZ_HASH_BITS);
+}
+
+/* chains every position below pos that starts a 3-byte string, and
+ * unchains the ones falling out of the window of pos
+ */
+static void _enc_insert(struct yazCtx *ctx, uint8_t *data, uint32_t pos, uint32_t sz) {
+	uint32_t p;
+	for (p = ctx->inserted; p < pos && p + 3 <= sz; p++) {
+		int32_t *next = ctx->next + p % YAZ_WINDOW;
+		uint32_t h;
 		
-		int i, p;
-		// check for needle
-		for (i = 0, p = index; i < needle_len; i++, p++) {
-			if (array[p] != needle[i])
-				break;
+		// p takes the slot of p - YAZ_WINDOW, the oldest position of its chain
+		if (p >= ctx->first + YAZ_WINDOW) {
+			h = _enc_hash(data + p - YAZ_WINDOW);
+			ctx->tail[h] = *next;
+			if (*next == YAZ_NIL)
+				ctx->head[h] = YAZ_NIL;
 		}
-		if(i==needle_len) {
-			// needle was found
-			return index;
-		}
-		// continue to search for needle
-		start_index = index + 1;
+		
+		h = _enc_hash(data + p);
+		*next = YAZ_NIL;
+		if (ctx->head[h] == YAZ_NIL)
+			ctx->tail[h] = p;
+		else
+			ctx->next[ctx->head[h] % YAZ_WINDOW] = p;
+		ctx->head[h] = p;
 	}
-	return -1;
+	ctx->inserted = max(ctx->inserted, pos);
 }
 
+/* returns { hitp, hitl }, the longest match (capped to cap) for pos among
+ * the YAZ_WINDOW previous positions, or { 0, 0 } if it's shorter than 3;
+ * of the positions matching as much, the oldest one wins, which is what
+ * the original brute force search (scanning the window forward and only
+ * taking strictly longer matches) found, so the output doesn't change
+ * positions must be searched in increasing order (repeats are fine)
+ */
 static int *_enc_search(struct yazCtx *ctx, uint8_t *data, uint32_t pos, uint32_t sz, uint32_t cap/*=0x111*/) {
 	int *return_data = ctx->return_data;
-	// this is necessary unless pos is signed, so let's play it safe
-	int mp = (pos>0x1000)?(pos-0x1000):0;
-	int ml = min(cap, sz - pos);
-	if(ml<3) {
-		return_data[0]=return_data[1]=0;
+	uint32_t ml = min(cap, sz - pos);
+	return_data[0]=return_data[1]=0;
+	if(ml<3)
 		return return_data;
-	}
-	int
-		hitp = 0,
-		hitl = 3,
-		hl = -1
-	;
 	
-	if (mp < pos) {
-		hl = _enc_find(ctx, data+mp, data+pos, hitl, 0, pos + hitl - mp);
-		while (hl < (pos - mp)) {
-			while ((hitl < ml) && (data[pos + hitl] == data[mp + hl + hitl]) ) {
-				hitl += 1;
-			}
-			mp += hl;
-			hitp = mp;
-			if (hitl == ml) {
-				return_data[0] = hitp;
-				return_data[1] = hitl;
-				return return_data;
-			}
-			mp += 1;
-			hitl += 1;
-			if (mp >= pos)
+	_enc_insert(ctx, data, pos, sz);
+	
+	uint32_t hitl = 2;
+	int32_t c;
+	for (c = ctx->tail[_enc_hash(data + pos)]; c != YAZ_NIL; c = ctx->next[c % YAZ_WINDOW]) {
+		uint8_t *cand = data + c;
+		uint32_t l;
+		
+		// only a strictly longer match is taken
+		if (cand[hitl] != data[pos + hitl])
+			continue;
+		for (l = 0; l < ml && cand[l] == data[pos + l]; l++)
+			;
+		if (l > hitl) {
+			hitl = l;
+			return_data[0] = c;
+			return_data[1] = hitl;
+			if (hitl == ml)
 				break;
-			hl = _enc_find(ctx, data+mp, data+pos, hitl, 0, pos + hitl - mp);
 		}
 	}
 	
-	// if length < 4, return miss
-	if (hitl < 4)
-		hitl = 1;
-	
-	return_data[0] = hitp;
-	return_data[1] = hitl-1;
 	return return_data;
 }
 
+/* encodes data[start, data_size); matches can reach back before start,
+ * so a stream that doesn't start at 0 only decodes after the data before
+ * it, see yazenc_block
+ */
 static
-uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *output, const char *mode) {
+uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t start, uint32_t data_size, uint8_t *output, const char *mode) {
 	uint32_t
 		cap=0x111,
 		sz=data_size,
-		pos=0,
+		pos=start,
 		flag=0x80000000
 	;
+	// start new chains, from the window before start
+	memset(ctx->head, 0xFF, (1 << YAZ_HASH_BITS) * sizeof(*ctx->head));
+	memset(ctx->tail, 0xFF, (1 << YAZ_HASH_BITS) * sizeof(*ctx->tail));
+	ctx->first = (start>YAZ_WINDOW)?(start-YAZ_WINDOW):0;
+	ctx->inserted = ctx->first;
+	
 	// initialize count of each to 0
 	stb__sbn(ctx->raws)=0;
 	stb__sbn(ctx->ctrl)=0;
@@ -207,7 +240,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 	
 	sb_push(ctx->cmds, 0);
 	
-	if(data_size==0) {
+	if(start==data_size) {
 		memcpy(output, mode, 4);
 		int i;
 		for(i=4; i<16; i++)
@@ -215,7 +248,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 		return 16;
 	}
 	while(pos<sz) {
-		int *search_return = _enc_search(ctx, data, pos, sz, cap);
+		int *search_return = ctx->search(ctx, data, pos, sz, cap);
 		
 		int hitp = search_return[0];
 		int hitl = search_return[1];
@@ -226,7 +259,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 			ctx->cmds[sb_count(ctx->cmds)-1] |= flag;
 			pos += 1;
 		} else {
-			search_return = _enc_search(ctx, data, pos+1, sz, cap);
+			search_return = ctx->search(ctx, data, pos+1, sz, cap);
 			int tstp = search_return[0];
 			int tstl = search_return[1];
 			
@@ -277,7 +310,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 		uint32_t l = (sb_count(ctx->cmds) << 2) + 16;
 		uint32_t o = (sb_count(ctx->ctrl) << 1) + l;
 		memcpy(output, mode, 4);
-		U32wr(output+4, sz);
+		U32wr(output+4, sz - start);
 		U32wr(output+8, l);
 		U32wr(output+12, o);
 		
@@ -297,7 +330,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 		return output_position;
 	} else if(mode_stream) {
 		memcpy(output, mode, 4);
-		U32wr(output+4, sz);
+		U32wr(output+4, sz - start);
 		U32wr(output+8, 0);
 		U32wr(output+12, 0);
 		
@@ -315,7 +348,7 @@ uint32_t encode(struct yazCtx *ctx, uint8_t *data, uint32_t data_size, uint8_t *
 			sb_push(ctx->back, (ctx->ctrl[x]>>8)&0xFF);
 			sb_push(ctx->back, (ctx->ctrl[x])&0xFF);
 		}
-		output_position = _enc_z_from_tables(ctx, ctx->ctl, ctx->back, ctx->raws, output+16, data_size, mode);
+		output_position = _enc_z_from_tables(ctx, ctx->ctl, ctx->back, ctx->raws, output+16, sz - start, mode);
 		return 16 + output_position;
 	}
 	return 0;
@@ -335,10 +368,98 @@ yazenc(
 	unsigned char *dst = _dst;
 	if (!_ctx)
 		return 1;
-	*dst_sz = encode(_ctx, src, src_sz, dst, "Yaz0");
+	*dst_sz = encode(_ctx, src, 0, src_sz, dst, "Yaz0");
 	return 0;
 }
 
+int
+yazenc_block(
+	void *_src
+	, unsigned start
+	, unsigned end
+	, void *_dst
+	, unsigned *dst_sz
+	, void *_ctx
+)
+{
+	unsigned char *src = _src;
+	unsigned char *dst = _dst;
+	if (!_ctx)
+		return 1;
+	*dst_sz = encode(_ctx, src, start, end, dst, "Yaz0");
+	return 0;
+}
+
+/* joins the blocks into one Yaz0 stream: the items (copied bytes and back
+ * references) of every block are copied as they are, only the control
+ * bytes saying which is which are rebuilt, since the last one of a block
+ * isn't always full
+ */
+unsigned
+yazjoin(void *_dst, unsigned dst_dec_sz, void **blocks, unsigned *dec_szs, int num)
+{
+	unsigned char *dst = _dst;
+	unsigned char *ctl = 0;
+	unsigned dst_pos = 16;
+	int ctl_bits = 0;
+	int i;
+	
+	memcpy(dst, "Yaz0", 4);
+	U32wr(dst+4, dst_dec_sz);
+	U32wr(dst+8, 0);
+	U32wr(dst+12, 0);
+	
+	for (i = 0; i < num; ++i)
+	{
+		unsigned char *src = (unsigned char*)blocks[i] + 16;
+		unsigned char code = 0;
+		int code_bits = 0;
+		int remaining = dec_szs[i];
+		
+		while (remaining > 0)
+		{
+			if (!code_bits)
+			{
+				code = *(src++);
+				code_bits = 8;
+			}
+			if (!ctl_bits)
+			{
+				ctl = dst + dst_pos++;
+				*ctl = 0;
+				ctl_bits = 8;
+			}
+			
+			if (code & 0x80)
+			{
+				*ctl |= 1 << (ctl_bits - 1);
+				dst[dst_pos++] = *(src++);
+				remaining -= 1;
+			}
+			else
+			{
+				unsigned char byte1 = *(src++);
+				
+				dst[dst_pos++] = byte1;
+				dst[dst_pos++] = *(src++);
+				if (byte1 >> 4)
+					remaining -= (byte1 >> 4) + 2;
+				else
+				{
+					remaining -= *src + 0x12;
+					dst[dst_pos++] = *(src++);
+				}
+			}
+			
+			code <<= 1;
+			code_bits -= 1;
+			ctl_bits -= 1;
+		}
+	}
+	
+	return dst_pos;
+}
+
 /* yaz decoder, courtesy of spinout182 */
 int
 yazdec(void *_src, void *_dst, unsigned dstSz, unsigned *srcSz)
@@ -178,6 +178,15 @@ static void usage(void)
 	fprintf(printer, "                   cache to persist across power cycles\n");
 	fprintf(printer, "                   can use the path \"/tmp/z64compress\"\n");
 	fprintf(printer, "\n");
+	fprintf(printer, "    --cache-max    how many mb the cache can grow to before\n");
+	fprintf(printer, "                   removing the least recently used files\n");
+	fprintf(printer, "                   (default 256; 0 keeps only the files of\n");
+	fprintf(printer, "                   this rom)\n");
+	fprintf(printer, "\n");
+	fprintf(printer, "    --cache-hash   hash naming the cached files\n");
+	fprintf(printer, "                      murmur3 (default, fastest)\n");
+	fprintf(printer, "                      sha1 (caches made before murmur3)\n");
+	fprintf(printer, "\n");
 	fprintf(printer, "    --dma          specify dmadata address and count\n");
 	fprintf(printer, "\n");
 	fprintf(printer, "    --compress     enable compression on specified files\n");
@@ -189,6 +198,13 @@ static void usage(void)
 	fprintf(printer, "    --threads      optional multithreading;\n");
 	fprintf(printer, "                   exclude this argument to disable it\n");
 	fprintf(printer, "\n");
+	fprintf(printer, "    --split        split files larger than this many kb\n");
+	fprintf(printer, "                   into blocks compressed by all threads\n");
+	fprintf(printer, "                 * yaz only, ignored with --matching;\n");
+	fprintf(printer, "                   compression is very slightly worse\n");
+	fprintf(printer, "                 * split files are cached apart from\n");
+	fprintf(printer, "                   the same files compressed whole\n");
+	fprintf(printer, "\n");
 	fprintf(printer, "    --only-stdout  reserve stderr for errors and print\n");
 	fprintf(printer, "                   everything else to stdout\n");
 	fprintf(printer, "\n");
@@ -208,6 +224,9 @@ wow_main
 	int Amb = 0;
 	int Athreads = 0;
 	bool Amatching = false;
+	bool Asplit = false;
+	bool Acache_max = false;
+	const char *Acache_hash = 0;
 	bool Aonly_stdout = false;
 	wow_main_argv;
 
@@ -281,6 +300,32 @@ wow_main
 			Acache = next;
 			rom_set_cache(rom, Acache);
 		}
+		else if (!strcmp(arg, "--cache-max"))
+		{
+			int mb;
+			
+			if (!Ain)
+				die("--cache-max arg provided before --in arg");
+			if (Acache_max)
+				die("--cache-max arg provided more than once");
+			if (sscanf(next, "%i", &mb) != 1)
+				die("--cache-max could not get value from string '%s'", next);
+			if (mb < 0)
+				die("--cache-max invalid value %d", mb);
+			Acache_max = true;
+			rom_set_cache_max(rom, mb * 1024ULL * 1024);
+		}
+		else if (!strcmp(arg, "--cache-hash"))
+		{
+			if (!Ain)
+				die("--cache-hash arg provided before --in arg");
+			if (Acache_hash)
+				die("--cache-hash arg provided more than once");
+			if (strcmp(next, "murmur3") && strcmp(next, "sha1"))
+				die("--cache-hash unknown hash '%s'", next);
+			Acache_hash = next;
+			rom_set_cache_hash(rom, Acache_hash);
+		}
 		else if (!strcmp(arg, "--codec"))
 		{
 			if (Acodec)
@@ -344,6 +389,21 @@ wow_main
 			if (Athreads < 0)
 				die("--threads invalid value %d", Athreads);
 		}
+		else if(!strcmp(arg, "--split"))
+		{
+			int kb;
+			
+			if (!Ain)
+				die("--split arg provided before --in arg");
+			if (Asplit)
+				die("--split arg provided more than once");
+			if (sscanf(next, "%i", &kb) != 1)
+				die("--split could not get value from string '%s'", next);
+			if (kb <= 0)
+				die("--split invalid value %d", kb);
+			Asplit = true;
+			rom_set_split(rom, kb * 1024);
+		}
 		else
 		{
 			die("unknown argument '%s'", arg);
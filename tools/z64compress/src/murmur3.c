@@ -0,0 +1,118 @@
+/* 
+ * murmur3.c
+ * 
+ * MurmurHash3_x64_128, from Austin Appleby's public domain SMHasher;
+ * the result is the same on every host, whatever its byte order
+ * 
+ */
+
+#include <stdint.h>
+
+#include "murmur3.h"
+
+#define ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static uint64_t get64le(const unsigned char *p)
+{
+	return (uint64_t)p[0]
+		| ((uint64_t)p[1] << 8)
+		| ((uint64_t)p[2] << 16)
+		| ((uint64_t)p[3] << 24)
+		| ((uint64_t)p[4] << 32)
+		| ((uint64_t)p[5] << 40)
+		| ((uint64_t)p[6] << 48)
+		| ((uint64_t)p[7] << 56)
+	;
+}
+
+static void put64le(unsigned char *p, uint64_t v)
+{
+	int i;
+	
+	for (i = 0; i < 8; ++i)
+		p[i] = v >> (i * 8);
+}
+
+static uint64_t fmix64(uint64_t k)
+{
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	
+	return k;
+}
+
+void murmur3_128(
+	const void *data
+	, unsigned int sz
+	, unsigned int seed
+	, unsigned char output[16]
+)
+{
+	const unsigned char *src = data;
+	const unsigned char *tail;
+	const uint64_t c1 = 0x87c37b91114253d5ULL;
+	const uint64_t c2 = 0x4cf5ad432745937fULL;
+	uint64_t h1 = seed;
+	uint64_t h2 = seed;
+	uint64_t k1;
+	uint64_t k2;
+	unsigned int i;
+	
+	/* body, 16 bytes at a time */
+	for (i = 0; i < sz / 16; ++i, src += 16)
+	{
+		k1 = get64le(src);
+		k2 = get64le(src + 8);
+		
+		k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+		h1 = ROTL64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+		
+		k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+		h2 = ROTL64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+	
+	/* tail, the last sz % 16 bytes */
+	tail = src;
+	k1 = 0;
+	k2 = 0;
+	switch (sz & 15)
+	{
+		case 15: k2 ^= (uint64_t)tail[14] << 48; /* fallthrough */
+		case 14: k2 ^= (uint64_t)tail[13] << 40; /* fallthrough */
+		case 13: k2 ^= (uint64_t)tail[12] << 32; /* fallthrough */
+		case 12: k2 ^= (uint64_t)tail[11] << 24; /* fallthrough */
+		case 11: k2 ^= (uint64_t)tail[10] << 16; /* fallthrough */
+		case 10: k2 ^= (uint64_t)tail[ 9] << 8;  /* fallthrough */
+		case  9: k2 ^= (uint64_t)tail[ 8];
+			k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+			/* fallthrough */
+		case  8: k1 ^= (uint64_t)tail[ 7] << 56; /* fallthrough */
+		case  7: k1 ^= (uint64_t)tail[ 6] << 48; /* fallthrough */
+		case  6: k1 ^= (uint64_t)tail[ 5] << 40; /* fallthrough */
+		case  5: k1 ^= (uint64_t)tail[ 4] << 32; /* fallthrough */
+		case  4: k1 ^= (uint64_t)tail[ 3] << 24; /* fallthrough */
+		case  3: k1 ^= (uint64_t)tail[ 2] << 16; /* fallthrough */
+		case  2: k1 ^= (uint64_t)tail[ 1] << 8;  /* fallthrough */
+		case  1: k1 ^= (uint64_t)tail[ 0];
+			k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+	}
+	
+	/* finalization */
+	h1 ^= sz;
+	h2 ^= sz;
+	
+	h1 += h2;
+	h2 += h1;
+	
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+	
+	h1 += h2;
+	h2 += h1;
+	
+	put64le(output, h1);
+	put64le(output + 8, h2);
+}
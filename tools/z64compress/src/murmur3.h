@@ -0,0 +1,15 @@
+#ifndef Z64COMPRESS_MURMUR3_H_INCLUDED
+#define Z64COMPRESS_MURMUR3_H_INCLUDED
+
+/* MurmurHash3_x64_128, by Austin Appleby (public domain): a fast
+ * non-cryptographic 128-bit hash, output as its two 64-bit halves
+ * in little-endian byte order
+ */
+void murmur3_128(
+	const void *data
+	, unsigned int sz
+	, unsigned int seed
+	, unsigned char output[16]
+);
+
+#endif /* Z64COMPRESS_MURMUR3_H_INCLUDED */
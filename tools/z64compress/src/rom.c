@@ -22,11 +22,12 @@
 
 /* threading */
 #include <pthread.h>
+#include <stdatomic.h>
 
 #include "enc/enc.h"  /* file compression */
 #include "enc/yar.h"  /* MM archive tools */
 
-#include "sha1.h"     /* sha1 helpers */
+#include "cache.h"    /* compression cache index */
 #include "n64crc.h"   /* n64crc() */
 
 #include "wow.h"
@@ -72,6 +73,9 @@ for (dma = rom->dma; (unsigned)(dma - rom->dma) < rom->dma_num; ++dma)
 #define ALIGN16(x) 	ALIGN(x, 16)
 #define ALIGN8MB(x) ALIGN(x, 8 * 0x100000)
 
+/* unused files are kept in the cache until it grows past this size */
+#define CACHE_MAX_DEFAULT (256ULL * 1024 * 1024)
+
 /*
  *
  * private types
@@ -101,6 +105,8 @@ struct dma
 	int               compress;  /* entry can be compressed    */
 	int               deleted;   /* points to deleted file     */
 	unsigned          compSz;    /* cache-less compressed size */
+	void             *splitbuf;  /* joined blocks of split file */
+	unsigned          splitSz;   /* size of joined blocks       */
 	unsigned int      start;     /* start offset               */
 	unsigned int      end;       /* end offset                 */
 	unsigned int      Pstart;    /* start of physical (P) data */
@@ -115,6 +121,9 @@ struct rom
 	char             *fn;        /* filename of loaded rom            */
 	char             *codec;     /* compression codec                 */
 	char             *cache;     /* compression cache                 */
+	unsigned long long cache_max; /* size the cache is trimmed to     */
+	char             *cache_hash; /* hash of cache keys, 0 = default  */
+	unsigned int      split;     /* block size of split files, or 0   */
 	unsigned char    *data;      /* raw rom data                      */
 	unsigned int      data_sz;   /* size of rom data                  */
 	unsigned int      ofs;       /* offset where rom_write() writes   */
@@ -133,18 +142,28 @@ struct rom
 };
 
 
-struct fldr_item
+/* the entries of rom->dma, handed out to the compression threads one at
+ * a time; a thread done with a file takes the next one, instead of every
+ * thread working through a fixed share of the list
+ */
+struct workQueue
 {
-	char             *name;      /* name  */
-	void             *udata;     /* udata */
+	atomic_uint       next;      /* next entry to hand out */
+	unsigned int      num;       /* number of entries */
+	unsigned int      reported;  /* last entry whose progress was shown */
+	pthread_mutex_t   report;    /* held by the thread showing progress */
+	void            (*show)(struct rom *rom, const char *codec, int v, int total);
 };
 
 
-struct folder
+/* part of a file too large to be compressed by a single thread */
+struct block
 {
-	struct fldr_item *item;      /* item array */
-	int               num;       /* number of items in array */
-	struct fldr_item *active;    /* active item */
+	struct dma       *dma;       /* file it belongs to         */
+	unsigned int      start;     /* start offset in the file   */
+	unsigned int      end;       /* end offset in the file     */
+	void             *compbuf;   /* compressed block           */
+	unsigned          compSz;    /* compressed block size      */
 };
 
 
@@ -161,10 +180,9 @@ struct compThread
 	);
 	const char *codec;
 	char *dot_codec;
-	struct folder *list;
-	int stride;   /* number of entries to advance each time */
-	int ofs;      /* starting entry in list */
-	int report;   /* report progress to stderr (last thread only) */
+	struct cache *cache; /* compression cache index */
+	struct workQueue *queue; /* entries to compress */
+	struct block *blocks; /* blocks the entries are, if splitting */
 	void *ctx;    /* compression context */
 	bool matching;
 	pthread_t pt; /* pthread */
@@ -284,145 +302,6 @@ static unsigned int file_write(
 }
 
 
-/* allocate a folder structure and parse current working directory */
-static struct folder *folder_new(void)
-{
-	wow_DIR *dir;
-	struct wow_dirent *ep;
-	struct fldr_item *item;
-	struct folder *folder;
-	char cwd[4096];
-	int count = 0;
-	int recount = 0;
-	
-	/* allocate a folder */
-	folder = calloc_safe(1, sizeof(*folder));
-	
-	/* get current working directory for error reporting */
-	wow_getcwd_safe(cwd, sizeof(cwd));
-	
-	/* first pass: count the contents */
-	dir = wow_opendir(".");
-	if (!dir)
-		die("failed to parse directory '%s'", cwd);
-	while ((ep = wow_readdir(dir)))
-		count += 1;
-	wow_closedir(dir);
-	
-	/* folder is empty */
-	if (!count)
-		die("folder '%s' is empty", cwd);
-	
-	/* allocate item array */
-	item = calloc_safe(count, sizeof(*item));
-	folder->item = item;
-	folder->num = count;
-	
-	/* second pass: retrieve requested contents */
-	dir = wow_opendir(".");
-	if (!dir)
-		die("failed to parse directory '%s'", cwd);
-	for (
-		recount = 0
-		; (ep = wow_readdir(dir)) && recount < count
-		; ++recount, ++item
-	)
-	{
-		const char *dn;
-		
-		dn = (const char*)ep->d_name;
-		
-		/* skip names starting with '.' (covers both "." and "..") */
-		if (*dn == '.')
-			continue;
-		
-		/* skip directories */
-		if (wow_is_dir(dn))
-			continue;
-		
-		/* make a copy of the string */
-		item->name = strdup_safe(dn);
-	}
-	
-	if (recount != count)
-		die("contents of '%s' changed during read, try again", cwd);
-	wow_closedir(dir);
-	
-	return folder;
-}
-
-
-/* free a folder structure */
-static void folder_free(struct folder *folder)
-{
-	if (!folder)
-		return;
-	
-	/* folder contains items */
-	if (folder->item)
-	{
-		struct fldr_item *item;
-		
-		/* walk item list, freeing resources owned by each */
-		for (
-			item = folder->item
-			; item - folder->item < folder->num
-			; ++item
-		)
-		{
-			if (item->name)
-				free(item->name);
-		}
-		
-		/* free item list */
-		free(folder->item);
-	}
-	
-	/* free folder */
-	free(folder);
-}
-
-
-/* locate folder item by name, ignoring extension (such as '.raw') */
-static struct fldr_item *folder_findNameNoExt(
-	struct folder *folder
-	, char *name
-)
-{
-	struct fldr_item *item;
-	
-	assert(folder);
-	assert(name);
-	
-	for (
-		item = folder->item
-		; item - folder->item < folder->num
-		; ++item
-	)
-	{
-		char *period;
-		int nchar;
-		
-		/* item has no name */
-		if (!item->name)
-			continue;
-		
-		/* doesn't contain a period */
-		if (!(period = strrchr(item->name, '.')))
-			continue;
-		
-		/* number of bytes to compare */
-		nchar = period - item->name;
-		
-		/* names match */
-		if (!memcmp(item->name, name, nchar))
-			return item;
-	}
-	
-	return 0;
-}
-
-
 /* retrieve encoder from name */
 static const struct encoder *encoder(const char *name)
 {
@@ -555,6 +434,120 @@ static void report_progress(
 		);
 }
 
+static void report_block_progress(
+	struct rom *rom
+	, const char *codec
+	, int v
+	, int total
+)
+{
+	/* caching enabled */
+	if (rom->cache)
+		fprintf(
+			printer
+			, "\r""updating '%s/%s' block %d/%d of large files: "
+			, rom->cache
+			, codec
+			, v
+			, total
+		);
+	
+	else
+		fprintf(
+			printer
+			, "\r""compressing block %d/%d of large files: "
+			, v
+			, total
+		);
+}
+
+/* set up a queue of 'num' entries */
+static void work_init(
+	struct workQueue *queue
+	, unsigned int num
+	, void show(struct rom *rom, const char *codec, int v, int total)
+)
+{
+	atomic_init(&queue->next, 0);
+	queue->num = num;
+	queue->reported = 0;
+	queue->show = show;
+	if (pthread_mutex_init(&queue->report, 0))
+		die("threading error");
+}
+
+/* take the next entry from the queue, or -1 once they're all taken;
+ * whichever thread takes an entry shows the progress, unless another
+ * thread is already doing so
+ */
+static int work_next(
+	struct workQueue *queue
+	, struct rom *rom
+	, const char *codec
+)
+{
+	unsigned int idx = atomic_fetch_add(&queue->next, 1);
+	
+	if (idx >= queue->num)
+		return -1;
+	
+	if (!pthread_mutex_trylock(&queue->report))
+	{
+		if (idx >= queue->reported)
+		{
+			queue->reported = idx;
+			queue->show(rom, codec, idx, queue->num);
+		}
+		pthread_mutex_unlock(&queue->report);
+	}
+	
+	return idx;
+}
+
+/* size of the blocks a file is compressed in, or 0 if it isn't split */
+static unsigned int dma_split(struct rom *rom, struct dma *dma)
+{
+	if (!dma->compress || dma->end - dma->start <= rom->split)
+		return 0;
+	
+	return rom->split;
+}
+
+
+/* compress a file, or take the joined blocks if it was split */
+static int dma_encode(
+	struct rom *rom
+	, struct dma *dma
+	, int encfunc(
+		void *src
+		, unsigned src_sz
+		, void *dst
+		, unsigned *dst_sz
+		, void *_ctx
+	)
+	, void *dst
+	, unsigned *dst_sz
+	, void *ctx
+)
+{
+	if (dma->splitbuf)
+	{
+		memcpy(dst, dma->splitbuf, dma->splitSz);
+		*dst_sz = dma->splitSz;
+		free(dma->splitbuf);
+		dma->splitbuf = 0;
+		return 0;
+	}
+	
+	return encfunc(
+		rom->data + dma->start
+		, dma->end - dma->start
+		, dst
+		, dst_sz
+		, ctx
+	);
+}
+
 /* compress a list of files */
 static void dma_compress(
 	struct rom *rom
@@ -568,32 +561,25 @@ static void dma_compress(
 	)
 	, const char *codec
 	, char *dot_codec
-	, struct folder *list
-	, int stride   /* number of entries to advance each time */
-	, int ofs      /* starting entry in list */
-	, int report   /* report progress to stderr (last thread only) */
+	, struct cache *cache
+	, struct workQueue *queue /* entries to compress */
 	, void *ctx    /* compression context */
 	, bool matching
 )
 {
 	struct dma *dma;
-	struct fldr_item *item;
+	int idx;
 	
-	for (dma = rom->dma + ofs
-		; (unsigned)(dma - rom->dma) < rom->dma_num
-		; dma += stride
-	)
+	while ((idx = work_next(queue, rom, codec)) >= 0)
 	{
+		dma = rom->dma + idx;
 		char *iname = 0;
 		unsigned char *data = rom->data + dma->start;
-		unsigned char checksum[64];
 		char readable[64];
+		char name[CACHE_NAME_SZ];
+		unsigned int sz;
 		int len = dma->end - dma->start;
 		
-		/* report the progress */
-		if (report)
-			report_progress(rom, codec, PROGRESS_A_B);
-		
 		/* skip files that have a size of 0 */
 		if (dma->start == dma->end)
 			continue;
@@ -616,9 +602,10 @@ static void dma_compress(
 			}
 			
 			err =
-			encfunc(
-				rom->data + dma->start
-				, dma->end - dma->start
+			dma_encode(
+				rom
+				, dma
+				, encfunc
 				, dma->compbuf
 				, &dma->compSz
 				, ctx
@@ -645,25 +632,20 @@ static void dma_compress(
 		}
 		
 		/* get readable checksum name */
-		stb_sha1(checksum, data, len);
-		stb_sha1_readable(readable, checksum);
+		cache_key(cache, data, len, dma_split(rom, dma), readable);
 		
-		/* see if item already exists in folder */
-		item = folder_findNameNoExt(list, readable);
-		if (item)
+		/* see if the file is cached, and wasn't removed since */
+		if (cache_find(cache, readable, name) && (sz = file_size(name)))
 		{
 			/* use full file name, including extension */
-			iname = item->name;
-			
-			/* it exists, so use udata to mark the file as used */
-			item->udata = dot_codec;
-			dma->compSz = file_size(iname);
+			iname = name;
+			dma->compSz = sz;
 			
 			/* uncompressed file */
 			if (strstr(iname, ".raw"))
 				dma->compress = 0;
 		}
-		/* item doesn't exist, so create it */
+		/* file isn't cached, so create it */
 		else
 		{
 			void *out = compbuf;
@@ -690,9 +672,10 @@ static void dma_compress(
 			}
 			
 			err =
-			encfunc(
-				rom->data + dma->start
-				, dma->end - dma->start
+			dma_encode(
+				rom
+				, dma
+				, encfunc
 				, out
 				, &out_sz
 				, ctx
@@ -740,10 +723,8 @@ static void *dma_compress_threadfunc(void *_CT)
 		, CT->encfunc
 		, CT->codec
 		, CT->dot_codec
-		, CT->list
-		, CT->stride
-		, CT->ofs
-		, CT->report
+		, CT->cache
+		, CT->queue
 		, CT->ctx
 		, CT->matching
 	);
@@ -765,10 +746,8 @@ static void dma_compress_thread(
 	)
 	, const char *codec
 	, char *dot_codec
-	, struct folder *list
-	, int stride   /* number of entries to advance each time */
-	, int ofs      /* starting entry in list */
-	, int report   /* report progress to stderr (last thread only) */
+	, struct cache *cache
+	, struct workQueue *queue /* entries to compress */
 	, void *ctx    /* compression context */
 	, bool matching
 )
@@ -778,10 +757,8 @@ static void dma_compress_thread(
 	CT->encfunc = encfunc;
 	CT->codec = codec;
 	CT->dot_codec = dot_codec;
-	CT->list = list;
-	CT->stride = stride;
-	CT->ofs = ofs;
-	CT->report = report;
+	CT->cache = cache;
+	CT->queue = queue;
 	CT->ctx = ctx;
 	CT->matching = matching;
 	
@@ -790,6 +767,175 @@ static void dma_compress_thread(
 }
 
 
+static void *dma_compress_blocks_threadfunc(void *_CT)
+{
+	struct compThread *CT = _CT;
+	int idx;
+	
+	while ((idx = work_next(CT->queue, CT->rom, CT->codec)) >= 0)
+	{
+		struct block *block = CT->blocks + idx;
+		
+		if (yazenc_block(
+				CT->rom->data + block->dma->start
+				, block->start
+				, block->end
+				, CT->data
+				, &block->compSz
+				, CT->ctx
+			)
+		)
+			die("compression error");
+		
+		block->compbuf = memdup_safe(CT->data, block->compSz);
+	}
+	
+	return 0;
+}
+
+
+/* returns non-zero if a file is already in the compression cache */
+static int dma_is_cached(struct rom *rom, struct dma *dma, struct cache *cache)
+{
+	char key[CACHE_KEY_MAX + 1];
+	char name[CACHE_NAME_SZ];
+	
+	if (!cache)
+		return 0;
+	
+	cache_key(
+		cache
+		, rom->data + dma->start
+		, dma->end - dma->start
+		, dma_split(rom, dma)
+		, key
+	);
+	
+	return cache_find(cache, key, name);
+}
+
+
+/* split the files to compress larger than rom->split into blocks of about
+ * that size, compress the blocks on every thread, then join the blocks of
+ * each file into its splitbuf, which dma_compress takes instead of
+ * compressing the file; the matches of a block can reach back into the
+ * block before it, but can't run past its end, so the result is a few
+ * bytes larger than compressing the file as a whole (yaz only)
+ */
+static void dma_compress_blocks(
+	struct rom *rom
+	, struct compThread *compThread
+	, int numThreads
+	, const char *codec
+	, struct cache *cache
+)
+{
+	struct workQueue queue;
+	struct block *blocks;
+	void **bufs;
+	unsigned *dec_szs;
+	struct dma *dma;
+	int max_num = 0;
+	int num = 0;
+	int i;
+	
+	/* at most this many blocks, if none of the files are cached */
+	DMA_FOR_EACH
+	{
+		if (dma->compress && dma->end - dma->start > rom->split)
+			max_num += (dma->end - dma->start + rom->split - 1) / rom->split;
+	}
+	if (!max_num)
+		return;
+	
+	blocks = calloc_safe(max_num, sizeof(*blocks));
+	bufs = calloc_safe(max_num, sizeof(*bufs));
+	dec_szs = calloc_safe(max_num, sizeof(*dec_szs));
+	
+	/* the blocks of a file are consecutive, in order */
+	DMA_FOR_EACH
+	{
+		unsigned int sz = dma->end - dma->start;
+		unsigned int block_sz;
+		unsigned int start;
+		
+		if (!dma_split(rom, dma) || dma_is_cached(rom, dma, cache))
+			continue;
+		
+		/* blocks of the same size */
+		block_sz = (sz + rom->split - 1) / rom->split;
+		block_sz = ALIGN16((sz + block_sz - 1) / block_sz);
+		
+		for (start = 0; start < sz; start += block_sz)
+		{
+			blocks[num].dma = dma;
+			blocks[num].start = start;
+			blocks[num].end = start + block_sz < sz ? start + block_sz : sz;
+			num += 1;
+		}
+	}
+	if (!num)
+	{
+		free(blocks);
+		free(bufs);
+		free(dec_szs);
+		return;
+	}
+	
+	/* compress them */
+	work_init(&queue, num, report_block_progress);
+	for (i = 0; i < numThreads; ++i)
+	{
+		compThread[i].rom = rom;
+		compThread[i].codec = codec;
+		compThread[i].queue = &queue;
+		compThread[i].blocks = blocks;
+		
+		if (pthread_create(&compThread[i].pt, 0, dma_compress_blocks_threadfunc, &compThread[i]))
+			die("threading error");
+	}
+	for (i = 0; i < numThreads; ++i)
+	{
+		if (pthread_join(compThread[i].pt, NULL))
+			die("threading error");
+	}
+	pthread_mutex_destroy(&queue.report);
+	report_block_progress(rom, codec, num, num);
+	fprintf(printer, "success!\n");
+	
+	/* join the blocks of each file */
+	for (i = 0; i < num; )
+	{
+		int first = i;
+		unsigned int sz = 16;
+		
+		dma = blocks[first].dma;
+		for (; i < num && blocks[i].dma == dma; ++i)
+		{
+			bufs[i] = blocks[i].compbuf;
+			dec_szs[i] = blocks[i].end - blocks[i].start;
+			sz += blocks[i].compSz - 16;
+		}
+		
+		dma->splitbuf = malloc_safe(sz);
+		dma->splitSz = yazjoin(
+			dma->splitbuf
+			, dma->end - dma->start
+			, bufs + first
+			, dec_szs + first
+			, i - first
+		);
+		
+		for (; first < i; ++first)
+			free(blocks[first].compbuf);
+	}
+	
+	free(blocks);
+	free(bufs);
+	free(dec_szs);
+}
+
+
 /* get dma entry by original index (useful after reordering) */
 static struct dma *dma_get_idx(struct rom *rom, unsigned idx)
 {
@@ -905,12 +1051,12 @@ static void rom_write_dmadata(struct rom *rom)
 void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 {
 	struct dma *dma;
-	struct folder *list = 0;
-	struct fldr_item *item;
+	struct cache *cacheIdx = 0;
 	char *dot_codec = 0;
 	const char *codec;
 	char cwd[4096] = {0};
 	char cache_codec[4096] = {0};
+	char cache_folder_name[CACHE_NAME_SZ];
 	const char *cache;
 	const struct encoder *enc = 0;
 	unsigned int compsz = mb * 0x100000;
@@ -919,6 +1065,7 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 	float total_compressed = 0;
 	float total_decompressed = 0;
 	struct compThread *compThread = 0;
+	struct workQueue queue = {0};
 	int dma_num = rom->dma_num;
 	int i;
 	
@@ -944,6 +1091,10 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 	/* get encoding functions */
 	enc = encoder(codec);
 	
+	/* files are only split by several yaz threads, for a non-matching rom */
+	if (matching || strcmp(codec, "yaz") || numThreads <= 1)
+		rom->split = 0;
+	
 	/* restore original start/end for nonexistent files */
 	DMA_FOR_EACH
 	{
@@ -986,7 +1137,11 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 	/* if using compression cache */
 	if (cache)
 	{
-		sprintf(cache_codec, "%s/%s/", cache, codec);
+		/* codec's folder for the files keyed with rom->cache_hash */
+		if (!cache_folder(cache_folder_name, codec, rom->cache_hash))
+			die("unknown cache hash '%s'", rom->cache_hash);
+		
+		sprintf(cache_codec, "%s/%s/", cache, cache_folder_name);
 		
 		/* store current working directory for later */
 		wow_getcwd_safe(cwd, sizeof(cwd));
@@ -995,18 +1150,23 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 		dir_enter(cache);
 		
 		/* create and enter directory for the encoding algorithm */
-		dir_enter(codec);
+		dir_enter(cache_folder_name);
 		
 		/* make a '.yaz' string from 'yaz' */
 		dot_codec = malloc_safe(strlen(codec) + 1/*'.'*/ + 1/*'\0'*/);
 		strcpy(dot_codec, ".");
 		strcat(dot_codec, codec);
 		
-		/* get list of all files in current working directory */
-		list = folder_new();
+		/* index of the files in current working directory */
+		cacheIdx = cache_open(codec, rom->cache_hash);
 	}
 	
-	/* now compress every compressible file */
+	/* the files too large for one thread are compressed by all of them */
+	if (rom->split)
+		dma_compress_blocks(rom, compThread, numThreads, codec, cacheIdx);
+	
+	/* now compress every compressible file, largest first */
+	work_init(&queue, rom->dma_num, report_progress);
 	if (numThreads <= 1)
 	{
 		dma_compress(
@@ -1015,10 +1175,8 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 			, enc->encfunc
 			, codec
 			, dot_codec
-			, list
-			, 1  /* stride */
-			, 0  /* ofs    */
-			, 1  /* report */
+			, cacheIdx
+			, &queue
 			, compThread[0].ctx
 			, matching
 		);
@@ -1035,10 +1193,8 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 				, enc->encfunc
 				, codec
 				, dot_codec
-				, list
-				, numThreads         /* stride */
-				, i                  /* ofs    */
-				, (i+1)==numThreads  /* report */
+				, cacheIdx
+				, &queue
 				, compThread[i].ctx
 				, matching
 			);
@@ -1052,6 +1208,25 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 		}
 	}
 	
+	pthread_mutex_destroy(&queue.report);
+	
+	/* the joined blocks of files found in the cache in the meantime */
+	DMA_FOR_EACH
+	{
+		free(dma->splitbuf);
+		dma->splitbuf = 0;
+	}
+	
+	/* mark the files of this rom as used in the cache */
+	if (cacheIdx)
+	{
+		DMA_FOR_EACH
+		{
+			if (dma->compname)
+				cache_use(cacheIdx, dma->compname, dma->compSz);
+		}
+	}
+	
 	/* all files now compressed */
 	report_progress(rom, codec, PROGRESS_A_B);
 	fprintf(printer, "success!\n");
@@ -1189,21 +1364,8 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 			free(dma->compname);
 	}
 	
-	/* remove unused cache files */
-	if (list)
-	{
-		for (item = list->item; item - list->item < list->num; ++item)
-		{
-			/* udata hasn't been marked, so file is unused */
-			if (item->name && !item->udata)
-			{
-				if (remove(item->name))
-					die("failed to remove '%s/%s/%s'"
-						, cache, codec, item->name
-					);
-			}
-		}
-	}
+	/* trim the cache, removing the least recently used files first */
+	cache_close(cacheIdx, rom->cache_max);
 	
 	/* update rom size for when rom_save() is used */
 	rom->data_sz = compsz;
@@ -1226,8 +1388,6 @@ void rom_compress(struct rom *rom, int mb, int numThreads, bool matching)
 		dma->compSz = 0;
 		dma->compbuf = 0;
 	}
-	if (list)
-		folder_free(list);
 	if (dot_codec)
 		free(dot_codec);
 	for (i = 0; i < numThreads; ++i)
@@ -1596,6 +1756,14 @@ void rom_dma_compress(
 }
 
 
+/* split files larger than block_sz bytes into blocks compressed in parallel */
+void rom_set_split(struct rom *rom, unsigned int block_sz)
+{
+	assert(rom);
+	
+	rom->split = block_sz;
+}
+
 /* set rom compressed file cache directory */
 void rom_set_cache(struct rom *rom, const char *cache)
 {
@@ -1608,6 +1776,26 @@ void rom_set_cache(struct rom *rom, const char *cache)
 	rom->cache = strdup_safe(cache);
 }
 
+/* set hash the compression cache keys are made with */
+void rom_set_cache_hash(struct rom *rom, const char *hash)
+{
+	assert(rom);
+	assert(hash);
+	
+	if (rom->cache_hash)
+		free(rom->cache_hash);
+	
+	rom->cache_hash = strdup_safe(hash);
+}
+
+/* set size the compression cache is trimmed to after compressing */
+void rom_set_cache_max(struct rom *rom, unsigned long long max_sz)
+{
+	assert(rom);
+	
+	rom->cache_max = max_sz;
+}
+
 /* get number of dma entries */
 int rom_dma_num(struct rom *rom)
 {
@@ -1663,6 +1851,8 @@ struct rom *rom_new(const char *fn)
 	/* back up load file name */
 	dst->fn = strdup_safe(fn);
 	
+	dst->cache_max = CACHE_MAX_DEFAULT;
+	
 	return dst;
 }
 
@@ -1684,6 +1874,9 @@ void rom_free(struct rom *rom)
 	if (rom->cache)
 		free(rom->cache);
 	
+	if (rom->cache_hash)
+		free(rom->cache_hash);
+	
 	if (rom->fn)
 		free(rom->fn);
 	
@@ -55,8 +55,25 @@ int rom_dma_num(struct rom *rom);
  */
 void rom_set_codec(struct rom *rom, const char *codec);
 
+/* split files larger than block_sz bytes into blocks of about that size,
+ * compressed in parallel by every thread
+ * NOTE: only with the yaz codec and multiple threads, ignored when matching
+ */
+void rom_set_split(struct rom *rom, unsigned int block_sz);
+
 /* set rom compressed file cache directory */
 void rom_set_cache(struct rom *rom, const char *cache);
 
+/* set hash the compression cache keys are made with, "murmur3" (default)
+ * or "sha1"; each hash has its own folder in the cache, sha1 the folder
+ * of the codec it always had
+ */
+void rom_set_cache_hash(struct rom *rom, const char *hash);
+
+/* set size the compression cache is trimmed to after compressing; the
+ * least recently used files that this rom doesn't use are removed first
+ */
+void rom_set_cache_max(struct rom *rom, unsigned long long max_sz);
+
 #endif /* Z64COMPRESS_ROM_H_INCLUDED */
 